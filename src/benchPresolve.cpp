@@ -0,0 +1,118 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*
+ * Measures the time per call of presolving the same (small) problem many
+ * times, once with a new Presolve instance per call and once with a single
+ * instance that is reused for all calls. The difference is the setup overhead
+ * that a long-lived instance saves.
+ */
+
+#include "papilo/core/Presolve.hpp"
+#include "papilo/core/Problem.hpp"
+#include "papilo/io/Parser.hpp"
+#include "papilo/misc/Timer.hpp"
+#include "papilo/misc/fmt.hpp"
+#include <cstdlib>
+
+using namespace papilo;
+
+static void
+setupPresolve( Presolve<double>& presolve, int threads )
+{
+   presolve.addDefaultPresolvers();
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   presolve.getPresolveOptions().threads = threads;
+}
+
+int
+main( int argc, char* argv[] )
+{
+   if( argc < 2 || argc > 4 )
+   {
+      fmt::print( "usage:\n" );
+      fmt::print( "./benchPresolve instance.mps [ncalls] [threads]  - "
+                  "measure the time per call of presolving instance.mps "
+                  "with a new and with a reused Presolve instance\n" );
+      return 1;
+   }
+
+   auto prob = Parser<double>::loadProblem( argv[1] );
+   if( !prob )
+   {
+      fmt::print( "error loading problem {}\n", argv[1] );
+      return 1;
+   }
+
+   const int ncalls = argc > 2 ? std::atoi( argv[2] ) : 1000;
+   const int threads = argc > 3 ? std::atoi( argv[3] ) : 0;
+   const Problem<double>& problem = prob.get();
+
+   // copying the problem is part of every call and measured separately
+   double copytime = 0.0;
+   {
+      Timer timer( copytime );
+      for( int i = 0; i < ncalls; ++i )
+      {
+         Problem<double> copy = problem;
+         (void) copy;
+      }
+   }
+
+   double freshtime = 0.0;
+   {
+      Timer timer( freshtime );
+      for( int i = 0; i < ncalls; ++i )
+      {
+         Problem<double> copy = problem;
+         Presolve<double> presolve;
+         setupPresolve( presolve, threads );
+         presolve.apply( copy );
+      }
+   }
+
+   double reusedtime = 0.0;
+   {
+      Presolve<double> presolve;
+      setupPresolve( presolve, threads );
+
+      Timer timer( reusedtime );
+      for( int i = 0; i < ncalls; ++i )
+      {
+         Problem<double> copy = problem;
+         presolve.apply( copy );
+      }
+   }
+
+   auto microsPerCall = [&]( double time ) {
+      return 1e6 * ( time - copytime ) / ncalls;
+   };
+
+   fmt::print( "problem {}: {} rows, {} columns, {} nonzeros, {} calls\n",
+               problem.getName(), problem.getNRows(), problem.getNCols(),
+               problem.getConstraintMatrix().getNnz(), ncalls );
+   fmt::print( "new instance per call: {:10.1f} us per call\n",
+               microsPerCall( freshtime ) );
+   fmt::print( "reused instance:       {:10.1f} us per call\n",
+               microsPerCall( reusedtime ) );
+
+   return 0;
+}
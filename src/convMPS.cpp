@@ -62,7 +62,7 @@ convMPS( const Problem<double>& prob )
    Vec<double> rowlhs = cm.getLeftHandSides();
    Vec<double> rowrhs = cm.getRightHandSides();
    Vec<RowFlags> row_flags = cm.getRowFlags();
-   const int nnz = cm.getNnz();
+   const NnzIndex nnz = cm.getNnz();
    const VariableDomains<double> vd = prob.getVariableDomains();
    const Vec<std::string> cnames = prob.getVariableNames();
    const Vec<std::string> rnames = prob.getConstraintNames();
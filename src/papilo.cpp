@@ -233,6 +233,23 @@ main( int argc, char* argv[] )
       case ArithmeticType::kRational:
          postsolve<papilo::Rational>( optionsInfo );
       }
+      break;
+   case Command::kBatch:
+      switch( optionsInfo.arithmetic_type )
+      {
+      case ArithmeticType::kDouble:
+         if( batch_presolve<double>( optionsInfo ) != ResultStatus::kOk )
+            return 1;
+         break;
+      case ArithmeticType::kQuad:
+         if( batch_presolve<Quad>( optionsInfo ) != ResultStatus::kOk )
+            return 1;
+         break;
+      case ArithmeticType::kRational:
+         if( batch_presolve<papilo::Rational>( optionsInfo ) !=
+             ResultStatus::kOk )
+            return 1;
+      }
    }
 
    return 0;
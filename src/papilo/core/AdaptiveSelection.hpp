@@ -0,0 +1,243 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_ADAPTIVE_SELECTION_HPP_
+#define _PAPILO_CORE_ADAPTIVE_SELECTION_HPP_
+
+#include "papilo/misc/Vec.hpp"
+#include "papilo/external/pdqsort/pdqsort.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+namespace papilo
+{
+
+/// prediction of the payoff and the cost of the next call of a presolver.
+/// The per call values decay exponentially such that recent calls dominate
+/// and a presolver that became productive again is recognized.
+struct PresolverEstimate
+{
+   /// predicted applied reductions, seconds and work units of the next call
+   double reductions = 0.0;
+   double time = 0.0;
+   double work = 0.0;
+   /// totals of the presolver when the estimate was last updated
+   unsigned int ncalls = 0;
+   double exectime = 0.0;
+   double totalwork = 0.0;
+   int64_t nreductions = 0;
+   /// number of consecutive times the presolver was skipped
+   int nskips = 0;
+   /// the presolver was skipped and has to run once more before it can be
+   /// skipped again
+   bool reprobe = false;
+
+   template <typename Archive>
+   void
+   serialize( Archive& ar, const unsigned int version )
+   {
+      ar& reductions;
+      ar& time;
+      ar& work;
+      ar& ncalls;
+      ar& exectime;
+      ar& totalwork;
+      ar& nreductions;
+      ar& nskips;
+      ar& reprobe;
+   }
+};
+
+/// decides which of the expensive presolvers run in a round. The candidates
+/// are ranked by their predicted reductions per share of the remaining time
+/// and work budget and are selected until the budget is used up. Skipped
+/// presolvers are probed again after a bounded number of rounds, so that the
+/// decision is revised when they become productive again.
+class AdaptiveSelection
+{
+ public:
+   /// number of calls before the payoff of a presolver is predicted
+   static constexpr unsigned int MIN_CALLS = 2;
+   /// weight of the previous estimate when a new call is observed
+   static constexpr double DECAY = 0.5;
+   /// maximum number of rounds a presolver is skipped before it is probed
+   static constexpr int MAX_SKIP_ROUNDS = 8;
+
+   void
+   resize( int npresolvers )
+   {
+      estimates.clear();
+      estimates.resize( npresolvers );
+   }
+
+   /// updates the estimate of the given presolver from its totals
+   void
+   update( int presolver, unsigned int ncalls, double exectime,
+           double totalwork, int64_t nreductions )
+   {
+      PresolverEstimate& estimate = estimates[presolver];
+      if( ncalls <= estimate.ncalls )
+         return;
+
+      const double newcalls = ncalls - estimate.ncalls;
+      const double reductions =
+          ( nreductions - estimate.nreductions ) / newcalls;
+      const double time = ( exectime - estimate.exectime ) / newcalls;
+      const double work = ( totalwork - estimate.totalwork ) / newcalls;
+
+      if( estimate.ncalls == 0 )
+      {
+         estimate.reductions = reductions;
+         estimate.time = time;
+         estimate.work = work;
+      }
+      else
+      {
+         estimate.reductions =
+             DECAY * estimate.reductions + ( 1.0 - DECAY ) * reductions;
+         estimate.time = DECAY * estimate.time + ( 1.0 - DECAY ) * time;
+         estimate.work = DECAY * estimate.work + ( 1.0 - DECAY ) * work;
+      }
+
+      estimate.ncalls = ncalls;
+      estimate.exectime = exectime;
+      estimate.totalwork = totalwork;
+      estimate.nreductions = nreductions;
+      estimate.reprobe = false;
+   }
+
+   bool
+   isPredictable( int presolver ) const
+   {
+      return estimates[presolver].ncalls >= MIN_CALLS;
+   }
+
+   /// selects among the given presolvers, whose estimates must be
+   /// predictable. Returns for each candidate the number of rounds it is
+   /// skipped, or 0 if it runs. A presolver is skipped if its predicted
+   /// reductions per second are below minrate or if the higher ranked
+   /// presolvers use up the remaining budget.
+   Vec<int>
+   select( const Vec<int>& candidates, double minrate, double remainingtime,
+           double remainingwork )
+   {
+      const double inf = std::numeric_limits<double>::max();
+      const bool bounded = remainingtime != inf || remainingwork != inf;
+
+      // share of the remaining budget used by the next call
+      auto cost = [&]( const PresolverEstimate& estimate ) {
+         double share = 0.0;
+         if( remainingtime != inf )
+            share = std::max( share, estimate.time /
+                                         std::max( remainingtime, 1e-9 ) );
+         if( remainingwork != inf )
+            share = std::max( share, estimate.work /
+                                         std::max( remainingwork, 1e-9 ) );
+         return share;
+      };
+      auto payoff = [&]( int presolver ) {
+         const PresolverEstimate& estimate = estimates[presolver];
+         if( bounded )
+            return estimate.reductions / std::max( cost( estimate ), 1e-12 );
+         return estimate.reductions / std::max( estimate.time, 1e-6 );
+      };
+
+      Vec<int> order( candidates.size() );
+      for( int k = 0; k != static_cast<int>( candidates.size() ); ++k )
+      {
+         assert( isPredictable( candidates[k] ) );
+         order[k] = k;
+      }
+
+      // presolvers that are probed again go first, the others by payoff
+      pdqsort( order.begin(), order.end(), [&]( int a, int b ) {
+         const int pa = candidates[a];
+         const int pb = candidates[b];
+         if( estimates[pa].reprobe != estimates[pb].reprobe )
+            return estimates[pa].reprobe;
+         const double payoffa = payoff( pa );
+         const double payoffb = payoff( pb );
+         return payoffa > payoffb || ( payoffa == payoffb && pa < pb );
+      } );
+
+      Vec<int> skiprounds( candidates.size(), 0 );
+      double used = 0.0;
+      for( int k : order )
+      {
+         PresolverEstimate& estimate = estimates[candidates[k]];
+         const double share = cost( estimate );
+         const double rate =
+             estimate.reductions / std::max( estimate.time, 1e-6 );
+
+         bool run;
+         if( estimate.reprobe )
+            run = share <= 1.0;
+         else
+            run = rate >= minrate && ( !bounded || used + share <= 1.0 );
+
+         if( run )
+         {
+            used += share;
+            if( !estimate.reprobe )
+               estimate.nskips = 0;
+         }
+         else
+         {
+            // back off further each time the presolver is skipped in a row,
+            // but probe it again after a bounded number of rounds
+            if( estimate.nskips < MAX_SKIP_ROUNDS )
+               ++estimate.nskips;
+            estimate.reprobe = true;
+            skiprounds[k] = estimate.nskips;
+         }
+      }
+
+      return skiprounds;
+   }
+
+   const PresolverEstimate&
+   getEstimate( int presolver ) const
+   {
+      return estimates[presolver];
+   }
+
+   const Vec<PresolverEstimate>&
+   getEstimates() const
+   {
+      return estimates;
+   }
+
+   Vec<PresolverEstimate>&
+   getEstimates()
+   {
+      return estimates;
+   }
+
+ private:
+   Vec<PresolverEstimate> estimates;
+};
+
+} // namespace papilo
+
+#endif
@@ -0,0 +1,412 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_BATCH_MATRIX_BUFFER_HPP_
+#define _PAPILO_CORE_BATCH_MATRIX_BUFFER_HPP_
+
+#include "papilo/core/SparseStorage.hpp"
+#include "papilo/misc/Hash.hpp"
+#include "papilo/misc/Vec.hpp"
+#ifdef PAPILO_TBB
+#include "papilo/misc/tbb.hpp"
+#endif
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+namespace papilo
+{
+
+/// entry of the BatchMatrixBuffer, for doubles an entry is 16 bytes
+template <typename REAL>
+struct BatchMatrixEntry
+{
+   REAL val;
+   int row;
+   int col;
+
+   BatchMatrixEntry() {}
+
+   BatchMatrixEntry( int _row, int _col, const REAL& _val )
+       : val( _val ), row( _row ), col( _col )
+   {
+   }
+};
+
+/// buffer for coefficient changes that only appends the entries and sorts
+/// them into row major and column major order with a radix sort once they are
+/// traversed. It provides the same traversal interface as the MatrixBuffer,
+/// but since the sorting is deferred, it is only suited if the entries are
+/// added in one batch before they are traversed. Entries with the same row
+/// and column are traversed in the order they were added.
+template <typename REAL>
+class BatchMatrixBuffer
+{
+ public:
+   BatchMatrixBuffer()
+   {
+      // dummy entry at position 0 marks the end of a traversal
+      entries.emplace_back( -1, -1, REAL{ 0 } );
+   }
+
+   bool
+   empty() const
+   {
+      return entries.size() == 1;
+   }
+
+   void
+   clear()
+   {
+      entries.resize( 1 );
+      row_major.clear();
+      col_major.clear();
+      latest.clear();
+      nindexed = 0;
+   }
+
+   void
+   addEntry( int row, int col, const REAL& val )
+   {
+      assert( row >= 0 && col >= 0 );
+      entries.emplace_back( row, col, val );
+   }
+
+   /// returns the most recently added entry for the given row and column or
+   /// nullptr if there is none. The lookup uses a hash index of the entries
+   /// that is extended by the entries added since the previous lookup, the
+   /// buffer is not sorted by this call. It must not be called concurrently.
+   template <bool RowMajor>
+   const BatchMatrixEntry<REAL>*
+   findEntry( int row, int col ) const
+   {
+      for( int i = nindexed + 1; i < (int) entries.size(); ++i )
+         latest[std::make_pair( entries[i].row, entries[i].col )] = i;
+      nindexed = (int) entries.size() - 1;
+
+      auto it = latest.find( std::make_pair( row, col ) );
+
+      return it == latest.end() ? nullptr : &entries[it->second];
+   }
+
+   /// starts the traversal in the given storage order. The stack argument
+   /// keeps the position of the traversal, as in the MatrixBuffer. Sorting
+   /// the row major and the column major order touches disjoint members,
+   /// hence both traversals may be started concurrently.
+   template <bool RowMajor>
+   const BatchMatrixEntry<REAL>*
+   begin( SmallVec<int, 32>& stack ) const
+   {
+      const Vec<int>& order = getSortedOrder<RowMajor>();
+
+      stack.clear();
+      stack.push_back( 0 );
+
+      return order.empty() ? end() : &entries[order[0]];
+   }
+
+   template <bool RowMajor>
+   const BatchMatrixEntry<REAL>*
+   next( SmallVec<int, 32>& stack ) const
+   {
+      const Vec<int>& order = RowMajor ? row_major : col_major;
+      assert( (NnzIndex) order.size() == getNnz() );
+
+      int k = ++stack.back();
+
+      return k == (int) order.size() ? end() : &entries[order[k]];
+   }
+
+   const BatchMatrixEntry<REAL>*
+   end() const
+   {
+      return &entries[0];
+   }
+
+   /// sorts the entries into both storage orders, in parallel if possible
+   void
+   sort() const
+   {
+#ifdef PAPILO_TBB
+      tbb::parallel_invoke( [this]() { getSortedOrder<true>(); },
+                            [this]() { getSortedOrder<false>(); } );
+#else
+      getSortedOrder<true>();
+      getSortedOrder<false>();
+#endif
+   }
+
+   void
+   reserve( NnzIndex nnz )
+   {
+      entries.reserve( nnz + 1 );
+   }
+
+   NnzIndex
+   getNnz() const
+   {
+      return entries.size() - 1;
+   }
+
+   SparseStorage<REAL>
+   buildCSR(
+       int nrows, int ncols,
+       double spareRatio = SparseStorage<REAL>::DEFAULT_SPARE_RATIO,
+       int mininterrowspace = SparseStorage<REAL>::DEFAULT_MIN_INTER_ROW_SPACE )
+   {
+      return buildStorage<true>( nrows, ncols, spareRatio, mininterrowspace );
+   }
+
+   SparseStorage<REAL>
+   buildCSC(
+       int nrows, int ncols,
+       double spareRatio = SparseStorage<REAL>::DEFAULT_SPARE_RATIO,
+       int minintercolspace = SparseStorage<REAL>::DEFAULT_MIN_INTER_ROW_SPACE )
+   {
+      return buildStorage<false>( ncols, nrows, spareRatio, minintercolspace );
+   }
+
+ private:
+   /// number of bits that are sorted per pass of the radix sort
+   static constexpr int RADIX_BITS = 11;
+   /// below this number of entries a comparison sort is used
+   static constexpr int RADIX_SORT_THRESHOLD = 1024;
+   /// minimal number of entries per chunk of the parallel radix sort
+   static constexpr int MIN_RADIX_CHUNK_SIZE = 1 << 14;
+
+   static int
+   getMajor( const BatchMatrixEntry<REAL>& entry, bool rowMajor )
+   {
+      return rowMajor ? entry.row : entry.col;
+   }
+
+   static int
+   getMinor( const BatchMatrixEntry<REAL>& entry, bool rowMajor )
+   {
+      return rowMajor ? entry.col : entry.row;
+   }
+
+   /// calls chunkFunc( c, first, last ) for nchunks consecutive chunks of
+   /// the range [0, n), in parallel if possible
+   template <typename ChunkFunc>
+   static void
+   forEachChunk( int n, int nchunks, ChunkFunc&& chunkFunc )
+   {
+      auto chunk = [&]( int c ) {
+         chunkFunc( c, int( int64_t( n ) * c / nchunks ),
+                    int( int64_t( n ) * ( c + 1 ) / nchunks ) );
+      };
+#ifdef PAPILO_TBB
+      if( nchunks > 1 )
+      {
+         tbb::parallel_for( tbb::blocked_range<int>( 0, nchunks, 1 ),
+                            [&]( const tbb::blocked_range<int>& r ) {
+                               for( int c = r.begin(); c != r.end(); ++c )
+                                  chunk( c );
+                            } );
+         return;
+      }
+#endif
+      for( int c = 0; c < nchunks; ++c )
+         chunk( c );
+   }
+
+   static int
+   countBits( int value )
+   {
+      int bits = 0;
+      while( ( value >> bits ) != 0 )
+         ++bits;
+      return bits;
+   }
+
+   template <bool RowMajor>
+   const Vec<int>&
+   getSortedOrder() const
+   {
+      Vec<int>& order = RowMajor ? row_major : col_major;
+
+      if( (NnzIndex) order.size() != getNnz() )
+         sortEntries( order, RowMajor );
+
+      return order;
+   }
+
+   /// stores the positions of the entries in the given storage order. The
+   /// major and the minor index are packed into one key that is sorted with a
+   /// least significant digit radix sort, which is stable and therefore keeps
+   /// entries with equal keys in insertion order. The entries are split into
+   /// chunks that are counted and scattered in parallel, each chunk scatters
+   /// to its own slice of every bucket, which keeps the sort stable.
+   void
+   sortEntries( Vec<int>& order, bool rowMajor ) const
+   {
+      const int n = (int) entries.size() - 1;
+
+      int maxmajor = 0;
+      int maxminor = 0;
+      for( int i = 1; i <= n; ++i )
+      {
+         maxmajor = std::max( maxmajor, getMajor( entries[i], rowMajor ) );
+         maxminor = std::max( maxminor, getMinor( entries[i], rowMajor ) );
+      }
+
+      const int minorbits = countBits( maxminor );
+      const int keybits = minorbits + countBits( maxmajor );
+
+      int nchunks = 1;
+#ifdef PAPILO_TBB
+      nchunks = std::max(
+          std::min( tbb::this_task_arena::max_concurrency(),
+                    n / MIN_RADIX_CHUNK_SIZE ),
+          1 );
+#endif
+
+      Vec<uint64_t> keys( n );
+      order.resize( n );
+
+      forEachChunk( n, nchunks, [&]( int, int first, int last ) {
+         for( int i = first; i < last; ++i )
+         {
+            const BatchMatrixEntry<REAL>& entry = entries[i + 1];
+            keys[i] = uint64_t( getMajor( entry, rowMajor ) ) << minorbits |
+                      uint64_t( getMinor( entry, rowMajor ) );
+            order[i] = i + 1;
+         }
+      } );
+
+      if( n < RADIX_SORT_THRESHOLD )
+      {
+         std::sort( order.begin(), order.end(), [&]( int a, int b ) {
+            return keys[a - 1] < keys[b - 1] ||
+                   ( keys[a - 1] == keys[b - 1] && a < b );
+         } );
+         return;
+      }
+
+      const int nbuckets = 1 << RADIX_BITS;
+      const uint64_t mask = uint64_t( nbuckets - 1 );
+      // count of each bucket per chunk, turned into the first position of
+      // the chunk in the bucket
+      Vec<int> count( size_t( nchunks ) * nbuckets );
+      Vec<uint64_t> tmpkeys( n );
+      Vec<int> tmporder( n );
+
+      for( int shift = 0; shift < keybits; shift += RADIX_BITS )
+      {
+         forEachChunk( n, nchunks, [&]( int c, int first, int last ) {
+            int* chunkcount = count.data() + size_t( c ) * nbuckets;
+            std::fill( chunkcount, chunkcount + nbuckets, 0 );
+
+            for( int i = first; i < last; ++i )
+               ++chunkcount[( keys[i] >> shift ) & mask];
+         } );
+
+         int sum = 0;
+         for( int d = 0; d < nbuckets; ++d )
+         {
+            for( int c = 0; c < nchunks; ++c )
+            {
+               int& pos = count[size_t( c ) * nbuckets + d];
+               int tmp = pos;
+               pos = sum;
+               sum += tmp;
+            }
+         }
+
+         forEachChunk( n, nchunks, [&]( int c, int first, int last ) {
+            int* chunkpos = count.data() + size_t( c ) * nbuckets;
+
+            for( int i = first; i < last; ++i )
+            {
+               const int pos = chunkpos[( keys[i] >> shift ) & mask]++;
+               tmpkeys[pos] = keys[i];
+               tmporder[pos] = order[i];
+            }
+         } );
+
+         keys.swap( tmpkeys );
+         order.swap( tmporder );
+      }
+   }
+
+   template <bool RowMajor>
+   SparseStorage<REAL>
+   buildStorage( int nmajor, int nminor, double spareRatio,
+                 int mininterspace ) const
+   {
+      const Vec<int>& order = getSortedOrder<RowMajor>();
+
+      SparseStorage<REAL> storage( nmajor, nminor, getNnz(), spareRatio,
+                                   mininterspace );
+
+      REAL* values = storage.getValues();
+      int* indices = storage.getColumns();
+      IndexRange* ranges = storage.getRowRanges();
+
+      NnzIndex k = 0;
+      int pos = 0;
+
+      for( int i = 0; i != nmajor; ++i )
+      {
+         ranges[i].start = k;
+
+         while( pos != (int) order.size() &&
+                getMajor( entries[order[pos]], RowMajor ) == i )
+         {
+            values[k] = entries[order[pos]].val;
+            indices[k] = getMinor( entries[order[pos]], RowMajor );
+
+            ++k;
+            ++pos;
+         }
+
+         ranges[i].end = k;
+
+         if( k != ranges[i].start )
+         {
+            int size = static_cast<int>( k - ranges[i].start );
+            k += storage.computeRowAlloc( size ) - size;
+         }
+      }
+
+      ranges[nmajor].start = storage.getNAlloc();
+      ranges[nmajor].end = storage.getNAlloc();
+
+      return storage;
+   }
+
+   Vec<BatchMatrixEntry<REAL>> entries;
+   mutable Vec<int> row_major;
+   mutable Vec<int> col_major;
+   // position of the most recent entry of each row and column, contains the
+   // entries up to position nindexed
+   mutable HashMap<std::pair<int, int>, int, boost::hash<std::pair<int, int>>>
+       latest;
+   mutable int nindexed = 0;
+};
+
+} // namespace papilo
+
+#endif
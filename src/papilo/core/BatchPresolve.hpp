@@ -0,0 +1,239 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_BATCH_PRESOLVE_HPP_
+#define _PAPILO_CORE_BATCH_PRESOLVE_HPP_
+
+#include "papilo/core/Presolve.hpp"
+#include "papilo/core/Problem.hpp"
+#include "papilo/misc/Timer.hpp"
+#include "papilo/misc/Vec.hpp"
+#ifdef PAPILO_TBB
+#include "papilo/misc/tbb.hpp"
+#endif
+#include <boost/optional.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace papilo
+{
+
+/// aggregated statistics of presolving a batch of problems
+struct BatchStatistics
+{
+   int ninstances = 0;
+   /// instances that could not be loaded
+   int nfailed = 0;
+   int nreduced = 0;
+   int nunchanged = 0;
+   /// instances detected to be infeasible or unbounded
+   int ninfeasible = 0;
+   int64_t nrowsbefore = 0;
+   int64_t ncolsbefore = 0;
+   int64_t nnzbefore = 0;
+   int64_t nrowsafter = 0;
+   int64_t ncolsafter = 0;
+   int64_t nnzafter = 0;
+   /// wall clock time of the batch
+   double walltime = 0.0;
+   /// sum of the presolving times of the instances
+   double presolvetime = 0.0;
+
+   /// presolved instances per second of wall clock time
+   double
+   getThroughput() const
+   {
+      return walltime > 0.0 ? ( ninstances - nfailed ) / walltime : 0.0;
+   }
+};
+
+/// presolves many problems concurrently on one task arena. Each thread of the
+/// arena keeps its own Presolve instance and reuses it for all problems it
+/// presolves, the parallelism within one problem is bounded by the number of
+/// instance threads.
+template <typename REAL>
+class BatchPresolve
+{
+ public:
+   using Setup = std::function<void( Presolve<REAL>& )>;
+
+   /// setup configures a new Presolve instance, i.e., adds the presolvers and
+   /// sets the parameters. It is called once for every thread of the batch,
+   /// the number of threads of the instance is overwritten afterwards.
+   explicit BatchPresolve( Setup setup_ ) : setup( std::move( setup_ ) ) {}
+
+   /// number of threads for the whole batch, 0 for automatic
+   void
+   setThreads( int value )
+   {
+      threads = value;
+   }
+
+   /// number of threads used to presolve a single problem
+   void
+   setInstanceThreads( int value )
+   {
+      instancethreads = value;
+   }
+
+   const BatchStatistics&
+   getStatistics() const
+   {
+      return stats;
+   }
+
+   /// presolves the problems load(0) to load(ninstances - 1). load returns an
+   /// empty optional if the problem can not be loaded. After presolving
+   /// handle(i, reduced problem, presolve result, presolve statistics) is
+   /// called. Both are called concurrently for different instances.
+   template <typename LOAD, typename HANDLE>
+   void
+   apply( int ninstances, LOAD&& load, HANDLE&& handle );
+
+   /// presolves the problems in place and returns their presolve results
+   Vec<PresolveResult<REAL>>
+   apply( Vec<Problem<REAL>>& problems );
+
+ private:
+   Setup setup;
+   int threads = 0;
+   int instancethreads = 1;
+   BatchStatistics stats;
+
+   std::unique_ptr<Presolve<REAL>>
+   createPresolve() const
+   {
+      std::unique_ptr<Presolve<REAL>> presolve( new Presolve<REAL>() );
+      setup( *presolve );
+      presolve->getPresolveOptions().threads = instancethreads;
+      return presolve;
+   }
+};
+
+template <typename REAL>
+template <typename LOAD, typename HANDLE>
+void
+BatchPresolve<REAL>::apply( int ninstances, LOAD&& load, HANDLE&& handle )
+{
+   stats = BatchStatistics();
+   stats.ninstances = ninstances;
+   std::mutex statsmutex;
+
+   auto presolve_instance = [&]( Presolve<REAL>& presolve, int i ) {
+      boost::optional<Problem<REAL>> problem = load( i );
+      if( !problem )
+      {
+         std::lock_guard<std::mutex> lock( statsmutex );
+         ++stats.nfailed;
+         return;
+      }
+
+      const int nrows = problem->getNRows();
+      const int ncols = problem->getNCols();
+      const int64_t nnz = problem->getConstraintMatrix().getNnz();
+
+      PresolveResult<REAL> result = presolve.apply( *problem, false );
+
+      {
+         std::lock_guard<std::mutex> lock( statsmutex );
+         switch( result.status )
+         {
+         case PresolveStatus::kReduced:
+            ++stats.nreduced;
+            break;
+         case PresolveStatus::kUnchanged:
+            ++stats.nunchanged;
+            break;
+         case PresolveStatus::kInfeasible:
+         case PresolveStatus::kUnbndOrInfeas:
+         case PresolveStatus::kUnbounded:
+            ++stats.ninfeasible;
+            break;
+         }
+         stats.nrowsbefore += nrows;
+         stats.ncolsbefore += ncols;
+         stats.nnzbefore += nnz;
+         stats.nrowsafter += problem->getNRows();
+         stats.ncolsafter += problem->getNCols();
+         stats.nnzafter += problem->getConstraintMatrix().getNnz();
+         stats.presolvetime += presolve.getStatistics().presolvetime;
+      }
+
+      handle( i, *problem, result, presolve.getStatistics() );
+   };
+
+   double walltime = 0.0;
+   {
+      Timer timer( walltime );
+#ifdef PAPILO_TBB
+      // every thread reuses its Presolve instance for the instances it takes
+      tbb::enumerable_thread_specific<std::unique_ptr<Presolve<REAL>>>
+          presolves;
+      tbb::task_arena arena( threads == 0 ? tbb::task_arena::automatic
+                                          : threads );
+
+      arena.execute( [&]() {
+         tbb::parallel_for(
+             tbb::blocked_range<int>( 0, ninstances, 1 ),
+             [&]( const tbb::blocked_range<int>& r ) {
+                std::unique_ptr<Presolve<REAL>>& presolve = presolves.local();
+                if( presolve == nullptr )
+                   presolve = createPresolve();
+                for( int i = r.begin(); i != r.end(); ++i )
+                   presolve_instance( *presolve, i );
+             },
+             tbb::simple_partitioner() );
+      } );
+#else
+      std::unique_ptr<Presolve<REAL>> presolve = createPresolve();
+      for( int i = 0; i < ninstances; ++i )
+         presolve_instance( *presolve, i );
+#endif
+   }
+   stats.walltime = walltime;
+}
+
+template <typename REAL>
+Vec<PresolveResult<REAL>>
+BatchPresolve<REAL>::apply( Vec<Problem<REAL>>& problems )
+{
+   Vec<PresolveResult<REAL>> results( problems.size() );
+
+   apply(
+       static_cast<int>( problems.size() ),
+       [&problems]( int i ) {
+          return boost::optional<Problem<REAL>>( std::move( problems[i] ) );
+       },
+       [&problems, &results]( int i, Problem<REAL>& problem,
+                              PresolveResult<REAL>& result,
+                              const Statistics& ) {
+          problems[i] = std::move( problem );
+          results[i] = std::move( result );
+       } );
+
+   return results;
+}
+
+} // namespace papilo
+
+#endif
@@ -0,0 +1,424 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_BLOCK_STRUCTURE_HPP_
+#define _PAPILO_CORE_BLOCK_STRUCTURE_HPP_
+
+#include "papilo/core/Problem.hpp"
+#include "papilo/misc/Hash.hpp"
+#include "papilo/misc/Vec.hpp"
+#include "papilo/misc/compress_vector.hpp"
+#include <algorithm>
+#include <boost/pending/disjoint_sets.hpp>
+#include <memory>
+
+namespace papilo
+{
+
+/// bordered block diagonal structure of the constraint matrix. After removing
+/// the linking rows and columns the remaining matrix decomposes into blocks
+/// that share no rows or columns.
+class BlockStructure
+{
+ public:
+   enum
+   {
+      /// block of the linking rows and columns and of deleted rows and
+      /// columns
+      LINKING = -1
+   };
+
+ private:
+   Vec<int> row2block;
+   Vec<int> col2block;
+   /// linking rows and columns at the time of the detection
+   Vec<int> linkingrows;
+   Vec<int> linkingcols;
+   int nblocks = 0;
+   int nlinkingrows = 0;
+   int nlinkingcols = 0;
+
+   /// sorts the items by their block, the linking items come last. The items
+   /// of block b are items[start[b]] to items[start[b + 1] - 1].
+   void
+   partition( const Vec<int>& item2block, Vec<int>& items,
+              Vec<int>& start ) const
+   {
+      const int nitems = static_cast<int>( item2block.size() );
+      start.assign( nblocks + 2, 0 );
+
+      for( int i = 0; i != nitems; ++i )
+      {
+         int b = item2block[i] == LINKING ? nblocks : item2block[i];
+         ++start[b + 1];
+      }
+
+      for( int b = 0; b != nblocks + 1; ++b )
+         start[b + 1] += start[b];
+
+      Vec<int> pos( start.begin(), start.end() - 1 );
+      items.resize( nitems );
+      for( int i = 0; i != nitems; ++i )
+      {
+         int b = item2block[i] == LINKING ? nblocks : item2block[i];
+         items[pos[b]++] = i;
+      }
+   }
+
+ public:
+   /// number of blocks without the linking part, at least 2 if a structure
+   /// was detected
+   int
+   getNBlocks() const
+   {
+      return nblocks;
+   }
+
+   bool
+   hasBlocks() const
+   {
+      return nblocks > 1;
+   }
+
+   int
+   getNLinkingRows() const
+   {
+      return nlinkingrows;
+   }
+
+   int
+   getNLinkingCols() const
+   {
+      return nlinkingcols;
+   }
+
+   int
+   getRowBlock( int row ) const
+   {
+      return row2block[row];
+   }
+
+   int
+   getColBlock( int col ) const
+   {
+      return col2block[col];
+   }
+
+   /// returns the rows sorted by block in rows and the start of each block
+   /// in start, the linking rows form the last block
+   void
+   getRowPartition( Vec<int>& rows, Vec<int>& start ) const
+   {
+      partition( row2block, rows, start );
+   }
+
+   /// returns the columns sorted by block in cols and the start of each block
+   /// in start, the linking columns form the last block
+   void
+   getColPartition( Vec<int>& cols, Vec<int>& start ) const
+   {
+      partition( col2block, cols, start );
+   }
+
+   void
+   clear()
+   {
+      row2block.clear();
+      col2block.clear();
+      linkingrows.clear();
+      linkingcols.clear();
+      nblocks = 0;
+      nlinkingrows = 0;
+      nlinkingcols = 0;
+   }
+
+   void
+   compress( const Vec<int>& rowmapping, const Vec<int>& colmapping,
+             bool full = false )
+   {
+      if( !hasBlocks() )
+         return;
+
+      compress_vector( rowmapping, row2block );
+      compress_vector( colmapping, col2block );
+      compress_index_vector( rowmapping, linkingrows );
+      compress_index_vector( colmapping, linkingcols );
+      if( full )
+      {
+         row2block.shrink_to_fit();
+         col2block.shrink_to_fit();
+         linkingrows.shrink_to_fit();
+         linkingcols.shrink_to_fit();
+      }
+   }
+
+   /// returns true if at most half of the linking rows and columns of the
+   /// detection are still active. Removing linking rows and columns can only
+   /// split the blocks further, so the structure should be detected again.
+   template <typename REAL>
+   bool
+   isStale( const Problem<REAL>& problem ) const
+   {
+      if( !hasBlocks() || nlinkingrows + nlinkingcols == 0 )
+         return false;
+
+      const Vec<RowFlags>& rflags =
+          problem.getConstraintMatrix().getRowFlags();
+      const Vec<ColFlags>& cflags = problem.getColFlags();
+      int nactive = 0;
+
+      for( int row : linkingrows )
+      {
+         if( !rflags[row].test( RowFlag::kRedundant ) )
+            ++nactive;
+      }
+      for( int col : linkingcols )
+      {
+         if( !cflags[col].test( ColFlag::kInactive ) )
+            ++nactive;
+      }
+
+      return 2 * nactive <= nlinkingrows + nlinkingcols;
+   }
+
+   /// detects a bordered block diagonal structure. At most maxlinkingfrac
+   /// times the number of rows (columns) of the longest rows (columns) are
+   /// considered as linking rows (columns). The blocks are the connected
+   /// components of the remaining matrix, candidates that touch only one
+   /// block are assigned to it afterwards. Returns the number of blocks, the
+   /// structure is only kept if there are at least two.
+   template <typename REAL>
+   int
+   detectBlocks( const Problem<REAL>& problem, double maxlinkingfrac )
+   {
+      clear();
+
+      const ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+      const int nrows = consMatrix.getNRows();
+      const int ncols = consMatrix.getNCols();
+      const Vec<int>& rowsizes = consMatrix.getRowSizes();
+      const Vec<int>& colsizes = consMatrix.getColSizes();
+      const Vec<RowFlags>& rflags = consMatrix.getRowFlags();
+      const Vec<ColFlags>& cflags = problem.getColFlags();
+
+      if( ncols == 0 )
+         return 0;
+
+      // the longest rows and columns are the candidates for the border, rows
+      // and columns with at most two entries are never linking
+      auto select_candidates = [maxlinkingfrac]( const Vec<int>& sizes,
+                                                 Vec<uint8_t>& candidate ) {
+         const int n = static_cast<int>( sizes.size() );
+         const int maxcandidates = static_cast<int>( maxlinkingfrac * n );
+         candidate.assign( n, false );
+
+         Vec<int> order( n );
+         for( int i = 0; i != n; ++i )
+            order[i] = i;
+
+         std::stable_sort( order.begin(), order.end(), [&]( int a, int b ) {
+            return sizes[a] > sizes[b];
+         } );
+
+         for( int k = 0; k != maxcandidates && sizes[order[k]] > 2; ++k )
+            candidate[order[k]] = true;
+      };
+
+      Vec<uint8_t> linkrow;
+      Vec<uint8_t> linkcol;
+      select_candidates( rowsizes, linkrow );
+      select_candidates( colsizes, linkcol );
+
+      std::unique_ptr<int[]> rank{ new int[ncols] };
+      std::unique_ptr<int[]> parent{ new int[ncols] };
+      boost::disjoint_sets<int*, int*> djsets( rank.get(), parent.get() );
+
+      for( int col = 0; col != ncols; ++col )
+         djsets.make_set( col );
+
+      for( int row = 0; row != nrows; ++row )
+      {
+         if( linkrow[row] || rflags[row].test( RowFlag::kRedundant ) )
+            continue;
+
+         auto rowvec = consMatrix.getRowCoefficients( row );
+         const int* inds = rowvec.getIndices();
+         int firstcol = -1;
+
+         for( int i = 0; i != rowvec.getLength(); ++i )
+         {
+            if( linkcol[inds[i]] )
+               continue;
+
+            if( firstcol == -1 )
+               firstcol = inds[i];
+            else
+               djsets.link( firstcol, inds[i] );
+         }
+      }
+
+      // number the components in the order of their first column, columns
+      // that only appear in candidate rows are part of the border
+      HashMap<int, int> blockmap;
+      col2block.assign( ncols, LINKING );
+
+      for( int col = 0; col != ncols; ++col )
+      {
+         if( linkcol[col] || cflags[col].test( ColFlag::kInactive ) )
+            continue;
+
+         auto colvec = consMatrix.getColumnCoefficients( col );
+         const int* inds = colvec.getIndices();
+         bool inblock = false;
+
+         for( int i = 0; i != colvec.getLength(); ++i )
+         {
+            if( !linkrow[inds[i]] &&
+                !rflags[inds[i]].test( RowFlag::kRedundant ) )
+            {
+               inblock = true;
+               break;
+            }
+         }
+
+         if( !inblock )
+            continue;
+
+         int nextid = static_cast<int>( blockmap.size() );
+         col2block[col] =
+             blockmap.emplace( djsets.find_set( col ), nextid ).first->second;
+      }
+
+      // block of the rows that are no candidates
+      row2block.assign( nrows, LINKING );
+
+      for( int row = 0; row != nrows; ++row )
+      {
+         if( linkrow[row] || rflags[row].test( RowFlag::kRedundant ) )
+            continue;
+
+         auto rowvec = consMatrix.getRowCoefficients( row );
+         const int* inds = rowvec.getIndices();
+
+         for( int i = 0; i != rowvec.getLength(); ++i )
+         {
+            if( !linkcol[inds[i]] )
+            {
+               row2block[row] = col2block[inds[i]];
+               break;
+            }
+         }
+      }
+
+      // candidate columns whose rows that are no candidates lie in one block
+      // belong to this block
+      for( int col = 0; col != ncols; ++col )
+      {
+         if( !linkcol[col] || cflags[col].test( ColFlag::kInactive ) )
+            continue;
+
+         auto colvec = consMatrix.getColumnCoefficients( col );
+         const int* inds = colvec.getIndices();
+         int block = LINKING;
+         bool linking = false;
+
+         for( int i = 0; i != colvec.getLength(); ++i )
+         {
+            int rowblock = row2block[inds[i]];
+            if( linkrow[inds[i]] || rowblock == LINKING || rowblock == block )
+               continue;
+
+            if( block != LINKING )
+            {
+               linking = true;
+               break;
+            }
+            block = rowblock;
+         }
+
+         if( !linking )
+            col2block[col] = block;
+      }
+
+      // candidate rows and rows without columns in a block whose columns lie
+      // in one block belong to this block. Rows with the same support thereby
+      // always end up in the same block.
+      for( int row = 0; row != nrows; ++row )
+      {
+         if( row2block[row] != LINKING ||
+             rflags[row].test( RowFlag::kRedundant ) )
+            continue;
+
+         auto rowvec = consMatrix.getRowCoefficients( row );
+         const int* inds = rowvec.getIndices();
+         int block = LINKING;
+         bool linking = false;
+
+         for( int i = 0; i != rowvec.getLength(); ++i )
+         {
+            int colblock = col2block[inds[i]];
+            if( colblock == LINKING || colblock == block )
+               continue;
+
+            if( block != LINKING )
+            {
+               linking = true;
+               break;
+            }
+            block = colblock;
+         }
+
+         if( !linking )
+            row2block[row] = block;
+      }
+
+      int numblocks = static_cast<int>( blockmap.size() );
+
+      if( numblocks <= 1 )
+      {
+         clear();
+         return numblocks;
+      }
+
+      nblocks = numblocks;
+      for( int row = 0; row != nrows; ++row )
+      {
+         if( row2block[row] == LINKING &&
+             !rflags[row].test( RowFlag::kRedundant ) )
+            linkingrows.push_back( row );
+      }
+      for( int col = 0; col != ncols; ++col )
+      {
+         if( col2block[col] == LINKING &&
+             !cflags[col].test( ColFlag::kInactive ) )
+            linkingcols.push_back( col );
+      }
+      nlinkingrows = static_cast<int>( linkingrows.size() );
+      nlinkingcols = static_cast<int>( linkingcols.size() );
+
+      return numblocks;
+   }
+};
+
+} // namespace papilo
+
+#endif
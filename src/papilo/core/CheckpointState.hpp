@@ -0,0 +1,103 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_CHECKPOINT_STATE_HPP_
+#define _PAPILO_CORE_CHECKPOINT_STATE_HPP_
+
+#include "papilo/misc/String.hpp"
+#include "papilo/misc/Vec.hpp"
+
+namespace papilo
+{
+
+/// state of a presolver that is kept over the rounds
+struct PresolverCheckpoint
+{
+   String name;
+   bool enabled = true;
+   bool delayed = false;
+   unsigned int ncalls = 0;
+   unsigned int nsuccessCall = 0;
+   unsigned int nconsecutiveUnsuccessCall = 0;
+   unsigned int skip = 0;
+   double execTime = 0.0;
+   double work = 0.0;
+   /// presolver specific data, e.g., how often probing probed each column
+   Vec<int> data;
+
+   template <typename Archive>
+   void
+   serialize( Archive& ar, const unsigned int version )
+   {
+      ar& name;
+      ar& enabled;
+      ar& delayed;
+      ar& ncalls;
+      ar& nsuccessCall;
+      ar& nconsecutiveUnsuccessCall;
+      ar& skip;
+      ar& execTime;
+      ar& work;
+      ar& data;
+   }
+};
+
+/// state of ProblemUpdate that is kept over the rounds
+struct ProblemUpdateCheckpoint
+{
+   Vec<int> singletonRows;
+   Vec<int> singletonColumns;
+   Vec<int> emptyColumns;
+   int firstNewSingletonCol = 0;
+   Vec<int> changed_activities;
+   Vec<int> deleted_cols;
+   Vec<int> redundant_rows;
+   Vec<int> random_col_perm;
+   Vec<int> random_row_perm;
+   Vec<int> row_modified_round;
+   Vec<int> col_modified_round;
+   int lastcompress_ndelcols = 0;
+   int lastcompress_ndelrows = 0;
+
+   template <typename Archive>
+   void
+   serialize( Archive& ar, const unsigned int version )
+   {
+      ar& singletonRows;
+      ar& singletonColumns;
+      ar& emptyColumns;
+      ar& firstNewSingletonCol;
+      ar& changed_activities;
+      ar& deleted_cols;
+      ar& redundant_rows;
+      ar& random_col_perm;
+      ar& random_row_perm;
+      ar& row_modified_round;
+      ar& col_modified_round;
+      ar& lastcompress_ndelcols;
+      ar& lastcompress_ndelrows;
+   }
+};
+
+} // namespace papilo
+
+#endif
@@ -128,7 +128,7 @@ class Components
 
          int firstcol = colinds[ranges[r].start];
 
-         for( int i = ranges[r].start + 1; i != ranges[r].end; ++i )
+         for( NnzIndex i = ranges[r].start + 1; i != ranges[r].end; ++i )
             djsets.link( firstcol, colinds[i] );
       }
 
@@ -157,12 +157,11 @@ class Components
          comprows.resize( nrows );
          for( int i = 0; i != nrows; ++i )
          {
-            assert( problem.getConstraintMatrix()
-                        .getRowCoefficients( i )
-                        .getLength() > 0 );
-            int col = problem.getConstraintMatrix()
-                          .getRowCoefficients( i )
-                          .getIndices()[0];
+            // empty rows do not connect any columns and are assigned to the
+            // component of the first column
+            const auto rowvec =
+                problem.getConstraintMatrix().getRowCoefficients( i );
+            int col = rowvec.getLength() > 0 ? rowvec.getIndices()[0] : 0;
             row2comp[i] = col2comp[col];
             comprows[i] = i;
          }
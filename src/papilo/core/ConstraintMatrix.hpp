@@ -26,6 +26,7 @@
 #define UNUSED(expr) do { (void)(expr); } while (0)
 
 
+#include "papilo/core/BatchMatrixBuffer.hpp"
 #include "papilo/core/MatrixBuffer.hpp"
 #include "papilo/core/Objective.hpp"
 #include "papilo/core/PresolveMethod.hpp"
@@ -183,7 +184,7 @@ class ConstraintMatrix
    }
 
    /// returns number of non-zeros in the constraint matrix
-   int
+   NnzIndex
    getNnz() const
    {
       assert( cons_matrix.getNnz() == cons_matrix_transp.getNnz() );
@@ -216,7 +217,7 @@ class ConstraintMatrix
       return SparseVectorView<REAL>{
           cons_matrix.getValues() + index_range.start,
           cons_matrix.getColumns() + index_range.start,
-          index_range.end - index_range.start };
+          static_cast<int>( index_range.end - index_range.start ) };
    }
 
    /// returns a sparse vector view on the column coefficients and their row
@@ -231,7 +232,7 @@ class ConstraintMatrix
       return SparseVectorView<REAL>{
           cons_matrix_transp.getValues() + index_range.start,
           cons_matrix_transp.getColumns() + index_range.start,
-          index_range.end - index_range.start };
+          static_cast<int>( index_range.end - index_range.start ) };
    }
 
    /// returns maximal change of constraint feasibility for the given change of
@@ -387,9 +388,9 @@ class ConstraintMatrix
       return colsize;
    }
 
-   template <typename CoeffChanged>
+   template <typename Buffer, typename CoeffChanged>
    void
-   changeCoefficients( const MatrixBuffer<REAL>& matrixBuffer,
+   changeCoefficients( const Buffer& matrixBuffer,
                        Vec<int>& singletonRows, Vec<int>& singletonCols,
                        Vec<int>& emptyCols, Vec<RowActivity<REAL>>& activities,
                        CoeffChanged&& coeffChanged )
@@ -403,8 +404,7 @@ class ConstraintMatrix
           [&]() {
 #endif
              SmallVec<int, 32> buffer;
-             const MatrixEntry<REAL>* iter =
-                 matrixBuffer.template begin<true>( buffer );
+             auto iter = matrixBuffer.template begin<true>( buffer );
 
              while( iter != matrixBuffer.end() )
              {
@@ -448,8 +448,7 @@ class ConstraintMatrix
              // update col major storage, do not pass down the coeffChanged
              // callback so that it
              /// is only called once
-             const MatrixEntry<REAL>* iter2 =
-                 matrixBuffer.template begin<false>( buffer2 );
+             auto iter2 = matrixBuffer.template begin<false>( buffer2 );
 
              while( iter2 != matrixBuffer.end() )
              {
@@ -747,7 +746,8 @@ ConstraintMatrix<REAL>::deleteRowsAndCols( Vec<int>& deletedRows,
           {
              assert( flags[row].test( RowFlag::kRedundant ) );
 
-             for( int i = rowranges[row].start; i != rowranges[row].end; ++i )
+             for( NnzIndex i = rowranges[row].start; i != rowranges[row].end;
+                  ++i )
              {
                 int col = rowcols[i];
                 if( colsize[col] == -1 )
@@ -773,7 +773,8 @@ ConstraintMatrix<REAL>::deleteRowsAndCols( Vec<int>& deletedRows,
 #endif
           for( int col : deletedCols )
           {
-             for( int i = colranges[col].start; i != colranges[col].end; ++i )
+             for( NnzIndex i = colranges[col].start; i != colranges[col].end;
+                  ++i )
              {
                 int row = colrows[i];
 
@@ -819,8 +820,8 @@ ConstraintMatrix<REAL>::deleteRowsAndCols( Vec<int>& deletedRows,
                 // now move contents of column to occupy free spaces
                 int j = 0;
 
-                for( int i = colranges[col].start; i != colranges[col].end;
-                     ++i )
+                for( NnzIndex i = colranges[col].start;
+                     i != colranges[col].end; ++i )
                 {
                    int row = colrows[i];
 
@@ -864,7 +865,8 @@ ConstraintMatrix<REAL>::deleteRowsAndCols( Vec<int>& deletedRows,
              // now move contents of row to occupy free spaces
              int j = 0;
 
-             for( int i = rowranges[row].start; i != rowranges[row].end; ++i )
+             for( NnzIndex i = rowranges[row].start; i != rowranges[row].end;
+                  ++i )
              {
                 int col = rowcols[i];
 
@@ -957,7 +959,7 @@ ConstraintMatrix<REAL>::checkAggregationSparsityCondition(
       fillin += ( len - i );
       totalfillin += fillin;
 
-      int sparespace = rowranges[row + 1].start - rowranges[row].end;
+      NnzIndex sparespace = rowranges[row + 1].start - rowranges[row].end;
 
       if( sparespace < fillin )
          shift = true;
@@ -1018,7 +1020,7 @@ ConstraintMatrix<REAL>::checkAggregationSparsityCondition(
 
       fillin += ( length - i );
 
-      int sparespace =
+      NnzIndex sparespace =
           colranges[currentcolind + 1].start - colranges[currentcolind].end;
 
       if( sparespace < fillin )
@@ -1058,8 +1060,8 @@ ConstraintMatrix<REAL>::sparsify(
    int* rowcols = cons_matrix.getColumns();
    REAL* rowvals = cons_matrix.getValues();
 
-   int j = eqrange.start;
-   int k = targetrange.start;
+   NnzIndex j = eqrange.start;
+   NnzIndex k = targetrange.start;
 
    while( j != eqrange.end && k != targetrange.end )
    {
@@ -1095,7 +1097,7 @@ ConstraintMatrix<REAL>::sparsify(
       }
    }
 
-   int remainingfillin = eqrange.end - j;
+   NnzIndex remainingfillin = eqrange.end - j;
 
    if( remainingfillin != 0 )
    {
@@ -1244,8 +1246,8 @@ ConstraintMatrix<REAL>::sparsify(
 
    int newsize = cons_matrix.changeRow(
        targetrow, eqrange.start, eqrange.end,
-       [&]( int i ) { return rowcols[i]; },
-       [&]( int i ) { return scale * rowvals[i]; },
+       [&]( NnzIndex i ) { return rowcols[i]; },
+       [&]( NnzIndex i ) { return scale * rowvals[i]; },
        [&]( const REAL& a, const REAL& b ) {
           REAL val = a + b;
           if( num.isZero( val ) )
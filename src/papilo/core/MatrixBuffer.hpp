@@ -362,7 +362,7 @@ struct MatrixBuffer
    }
 
    void
-   reserve( int nnz )
+   reserve( NnzIndex nnz )
    {
       entries.reserve( nnz + 1 );
    }
@@ -402,7 +402,7 @@ struct MatrixBuffer
       badge_start = -1;
    }
 
-   int
+   NnzIndex
    getNnz() const
    {
       return entries.size() - 1;
@@ -414,7 +414,7 @@ struct MatrixBuffer
        double spareRatio = SparseStorage<REAL>::DEFAULT_SPARE_RATIO,
        int mininterrowspace = SparseStorage<REAL>::DEFAULT_MIN_INTER_ROW_SPACE )
    {
-      int nnz = getNnz();
+      NnzIndex nnz = getNnz();
 
       SparseStorage<REAL> csrStorage( nrows, ncols, nnz, spareRatio,
                                       mininterrowspace );
@@ -428,7 +428,7 @@ struct MatrixBuffer
       const MatrixEntry<REAL>* it = this->begin<true>( stack );
       const MatrixEntry<REAL>* end = this->end();
 
-      int k = 0;
+      NnzIndex k = 0;
 
       for( int i = 0; i != nrows; ++i )
       {
@@ -465,7 +465,7 @@ struct MatrixBuffer
        double spareRatio = SparseStorage<REAL>::DEFAULT_SPARE_RATIO,
        int minintercolspace = SparseStorage<REAL>::DEFAULT_MIN_INTER_ROW_SPACE )
    {
-      int nnz = getNnz();
+      NnzIndex nnz = getNnz();
 
       SparseStorage<REAL> cscStorage( ncols, nrows, nnz, spareRatio,
                                       minintercolspace );
@@ -479,7 +479,7 @@ struct MatrixBuffer
       const MatrixEntry<REAL>* it = this->begin<false>( stack );
       const MatrixEntry<REAL>* end = this->end();
 
-      int k = 0;
+      NnzIndex k = 0;
 
       for( int i = 0; i != ncols; ++i )
       {
@@ -24,15 +24,23 @@
 #define _PAPILO_CORE_PRESOLVE_HPP_
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <fstream>
+#include <functional>
 #include <initializer_list>
 #include <memory>
+#include <tuple>
 #include <utility>
 
+#include "papilo/core/AdaptiveSelection.hpp"
+#include "papilo/core/Components.hpp"
+#include "papilo/core/PresolveCheckpoint.hpp"
 #include "papilo/core/PresolveMethod.hpp"
 #include "papilo/core/PresolveOptions.hpp"
+#include "papilo/core/ProblemDelta.hpp"
 #include "papilo/core/Problem.hpp"
+#include "papilo/core/ProblemBuilder.hpp"
 #include "papilo/core/ProblemUpdate.hpp"
 #include "papilo/core/Statistics.hpp"
 #include "papilo/core/postsolve/Postsolve.hpp"
@@ -75,6 +83,25 @@ struct PresolveResult
    PresolveStatus status;
 };
 
+/// calls and time of a presolver, passed to the progress callback
+struct PresolverProgress
+{
+   std::string name;
+   unsigned int ncalls;
+   double time;
+   double work;
+};
+
+/// state of presolve at the end of a round, passed to the progress callback
+struct PresolveProgress
+{
+   Statistics stats;
+   int nactiverows;
+   int nactivecols;
+   int64_t nnz;
+   Vec<PresolverProgress> presolvers;
+};
+
 enum class Delegator
 {
    kAbort,
@@ -152,6 +179,71 @@ class Presolve
    PresolveResult<REAL>
    apply( Problem<REAL>& problem, bool store_dual_postsolve = true );
 
+   /***
+    * continues presolving from a checkpoint that was passed to the checkpoint
+    * handler. The presolvers and parameters must be the same as in the
+    * interrupted presolve, the time limit applies to the resumed part only.
+    *
+    * @param problem: is set to the presolved problem
+    * @param checkpoint: the state of the interrupted presolve
+    * @return: PresolveResult with the postsolve information of the whole
+    * presolve
+    */
+   PresolveResult<REAL>
+   resume( Problem<REAL>& problem, PresolveCheckpoint<REAL> checkpoint );
+
+   /***
+    * applies the delta to the problem and presolves it. If presolve.warmstart
+    * is set and the previous call presolved the problem componentwise, only
+    * the parts that contain a modified row or column are presolved again and
+    * the presolved other parts are reused. The problem must be the one of the
+    * previous call and the presolvers and parameters must be the same.
+    * Otherwise the whole problem is presolved.
+    *
+    * @param problem: the problem of the previous call, is set to the
+    * presolved problem
+    * @param delta: the changes of the bounds, objective and sides
+    * @return: PresolveResult with the postsolve information
+    */
+   PresolveResult<REAL>
+   reapply( Problem<REAL>& problem, const ProblemDelta<REAL>& delta );
+
+   /// the handler is called at the end of a round if at least
+   /// presolve.checkpointinterval seconds passed since the start of presolve
+   /// or the previous checkpoint. Taking a checkpoint copies the problem and
+   /// the postsolve information.
+   void
+   setCheckpointHandler(
+       std::function<void( const PresolveCheckpoint<REAL>& )> handler )
+   {
+      checkpointHandler = std::move( handler );
+   }
+
+   /// the callback is called at the end of every round, presolve stops after
+   /// the round if it returns true
+   void
+   setProgressCallback(
+       std::function<bool( const PresolveProgress& )> callback )
+   {
+      progressCallback = std::move( callback );
+   }
+
+   /// requests the running call of apply(), resume() or reapply() to stop.
+   /// Can be called from another thread, presolve stops at the end of the
+   /// round and probing, domcol and sparsify stop within their call. The
+   /// reductions found so far are kept.
+   void
+   interrupt()
+   {
+      interruptflag->store( true, std::memory_order_relaxed );
+   }
+
+   bool
+   isInterrupted() const
+   {
+      return interruptflag->load( std::memory_order_relaxed );
+   }
+
    /// add presolve method to presolving
    void
    addPresolveMethod( std::unique_ptr<PresolveMethod<REAL>> presolveMethod )
@@ -265,10 +357,15 @@ class Presolve
                     ProblemUpdate<REAL>& probUpdate );
 
  private:
+   std::pair<int, int>
+   apply_transactions( int p, const Reductions<REAL>& reductions_,
+                       ProblemUpdate<REAL>& probUpdate );
+
    // data to perform presolving
    Vec<PresolveStatus> results;
    Vec<std::unique_ptr<PresolveMethod<REAL>>> presolvers;
    Vec<Reductions<REAL>> reductions;
+   RoundArena roundArena;
    Delegator round_to_evaluate;
 
    Vec<std::pair<const Reduction<REAL>*, const Reduction<REAL>*>>
@@ -290,14 +387,98 @@ class Presolve
    std::unique_ptr<SolverFactory<REAL>> satSolverFactory;
 
    Vec<std::pair<int, int>> presolverStats;
+   // number of changes to the problem when the presolver was last scheduled
+   // in concurrent rounds
+   Vec<int64_t> changesAtLastRun;
+   Vec<int> scheduledPresolvers;
+   // deterministic work of the presolvers in the current call of apply and
+   // the work they had done before
+   double presolvework{};
+   double initialwork{};
+   // predicted payoff and cost of the presolvers for the adaptive selection
+   AdaptiveSelection adaptiveSelection;
    bool lastRoundReduced{};
    int nunsuccessful{};
    bool rundelayed{};
+   // original indices of the rows and columns if the problem is a part of a
+   // larger problem that is presolved componentwise
+   Vec<int> part_origrow_mapping;
+   Vec<int> part_origcol_mapping;
+   std::function<void( const PresolveCheckpoint<REAL>& )> checkpointHandler;
+   std::function<bool( const PresolveProgress& )> progressCallback;
+   // set by interrupt(), shared with the presolves of the parts of component
+   // presolve
+   std::shared_ptr<std::atomic<bool>> interruptflag =
+       std::make_shared<std::atomic<bool>>( false );
+   // presolved part of the last component presolve, kept if
+   // presolve.warmstart is set
+   struct WarmstartPart
+   {
+      Vec<int> rows;
+      Vec<int> cols;
+      Problem<REAL> reduced;
+      PresolveResult<REAL> result;
+      Statistics stats;
+   };
+   Vec<WarmstartPart> warmstartparts;
+#ifdef PAPILO_TBB
+   // the arena is kept between the calls of apply and only created again if
+   // the number of threads changes
+   std::unique_ptr<tbb::task_arena> arena;
+   int arenathreads{};
+#endif
+
+   /// presolvers disable or delay themselves during apply depending on the
+   /// problem. The guard restores their settings when apply returns, such that
+   /// the instance can presolve further problems.
+   class PresolverSettingsGuard
+   {
+      Vec<std::tuple<PresolveMethod<REAL>*, bool, bool>> settings;
+
+    public:
+      explicit PresolverSettingsGuard(
+          const Vec<std::unique_ptr<PresolveMethod<REAL>>>& presolvers )
+      {
+         settings.reserve( presolvers.size() );
+         for( const auto& presolver : presolvers )
+            settings.emplace_back( presolver.get(), presolver->isEnabled(),
+                                   presolver->isDelayed() );
+      }
+
+      ~PresolverSettingsGuard()
+      {
+         for( const auto& setting : settings )
+         {
+            std::get<0>( setting )->setEnabled( std::get<1>( setting ) );
+            std::get<0>( setting )->setDelayed( std::get<2>( setting ) );
+         }
+      }
+   };
 
    /// evaluate result array of each presolver, return the largest result value
    PresolveStatus
    evaluateResults();
 
+   /// presolves the problem, or continues presolving from the checkpoint if
+   /// it is given
+   PresolveResult<REAL>
+   apply_internal( Problem<REAL>& problem, bool store_dual_postsolve,
+                   PresolveCheckpoint<REAL>* checkpoint,
+                   const ProblemDelta<REAL>* delta );
+
+   PresolveCheckpoint<REAL>
+   createCheckpoint( const Problem<REAL>& problem,
+                     const PostsolveStorage<REAL>& postsolve,
+                     const ProblemUpdate<REAL>& probUpdate,
+                     const Timer& timer ) const;
+
+   void
+   restoreCheckpoint( const PresolveCheckpoint<REAL>& checkpoint );
+
+   PresolveProgress
+   createProgress( const Problem<REAL>& problem,
+                   const ProblemUpdate<REAL>& probUpdate ) const;
+
    void
    finishRound( ProblemUpdate<REAL>& probUpdate );
 
@@ -366,11 +547,42 @@ class Presolve
                    const std::pair<int, int>& presolver_2_run,
                    ProblemUpdate<REAL>& probUpdate, bool& run_sequential, const Timer& timer );
 
+#ifdef PAPILO_TBB
+   void
+   run_presolvers_concurrently( const Problem<REAL>& problem,
+                                const std::pair<int, int>& presolver_2_run,
+                                ProblemUpdate<REAL>& probUpdate,
+                                const Timer& timer );
+#endif
+
+   int64_t
+   count_changes() const;
+
+   double
+   count_work() const;
+
+   bool
+   is_work_exceeded() const;
+
+   void
+   select_presolvers( const std::pair<int, int>& presolver_2_run,
+                      const Timer& timer );
+
    bool
    is_status_infeasible_or_unbounded( const PresolveStatus& status ) const;
 
    bool
    are_only_dual_postsolve_presolvers_enabled();
+
+   bool
+   apply_componentwise( Problem<REAL>& problem, const Timer& timer,
+                        PresolveResult<REAL>& result,
+                        const ProblemDelta<REAL>* delta );
+
+   void
+   add_to_builder( ProblemBuilder<REAL>& builder, const Problem<REAL>& problem,
+                   const Vec<int>& rows, const Vec<int>& cols,
+                   const Vec<int>& col2new, int firstrow ) const;
 };
 
 #ifdef PAPILO_USE_EXTERN_TEMPLATES
@@ -393,29 +605,98 @@ extern template class Presolve<Rational>;
 template <typename REAL>
 PresolveResult<REAL>
 Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
+{
+   return apply_internal( problem, store_dual_postsolve, nullptr, nullptr );
+}
+
+template <typename REAL>
+PresolveResult<REAL>
+Presolve<REAL>::resume( Problem<REAL>& problem,
+                        PresolveCheckpoint<REAL> checkpoint )
+{
+   bool samepresolvers = checkpoint.presolvers.size() == presolvers.size();
+   for( const auto& presolver : presolvers )
+   {
+      samepresolvers = samepresolvers &&
+                       std::any_of( checkpoint.presolvers.begin(),
+                                    checkpoint.presolvers.end(),
+                                    [&]( const PresolverCheckpoint& p ) {
+                                       return p.name == presolver->getName();
+                                    } );
+   }
+   if( !samepresolvers )
+      throw std::invalid_argument(
+          "the checkpoint was created with other presolvers" );
+
+   return apply_internal( problem, false, &checkpoint, nullptr );
+}
+
+template <typename REAL>
+PresolveResult<REAL>
+Presolve<REAL>::reapply( Problem<REAL>& problem,
+                         const ProblemDelta<REAL>& delta )
+{
+   return apply_internal( problem, false, nullptr, &delta );
+}
+
+template <typename REAL>
+PresolveResult<REAL>
+Presolve<REAL>::apply_internal( Problem<REAL>& problem,
+                                bool store_dual_postsolve,
+                                PresolveCheckpoint<REAL>* checkpoint,
+                                const ProblemDelta<REAL>* delta )
 {
 #ifdef PAPILO_TBB
-   tbb::task_arena arena( presolveOptions.threads == 0
-                              ? tbb::task_arena::automatic
-                              : presolveOptions.threads );
+   if( arena == nullptr || arenathreads != presolveOptions.threads )
+   {
+      arena.reset( new tbb::task_arena( presolveOptions.threads == 0
+                                            ? tbb::task_arena::automatic
+                                            : presolveOptions.threads ) );
+      arenathreads = presolveOptions.threads;
+   }
 #endif
 
 #ifdef PAPILO_TBB
-   return arena.execute( [this, &problem, store_dual_postsolve]() {
+   return arena->execute( [this, &problem, store_dual_postsolve, checkpoint,
+                           delta]() {
 #endif
+      PresolverSettingsGuard settingsGuard( presolvers );
+      for( const auto& presolver : presolvers )
+      {
+         presolver->resetCalls();
+         presolver->setInterruptFlag( interruptflag.get() );
+      }
+
+      // a part of component presolve keeps the request of the whole presolve
+      if( part_origcol_mapping.empty() )
+         interruptflag->store( false, std::memory_order_relaxed );
+
       stats = Statistics();
+      if( checkpoint != nullptr )
+      {
+         // the presolve time of the checkpoint is continued
+         stats = checkpoint->stats;
+         problem = std::move( checkpoint->problem );
+      }
       num.setFeasTol( REAL{ presolveOptions.feastol } );
       num.setEpsilon( REAL{ presolveOptions.epsilon } );
       num.setHugeVal( REAL{ presolveOptions.hugeval } );
 
       Timer timer( stats.presolvetime );
 
+      if( delta != nullptr )
+         delta->apply( problem, num );
+
       ConstraintMatrix<REAL>& constraintMatrix = problem.getConstraintMatrix();
       Vec<REAL>& rhsVals = constraintMatrix.getRightHandSides();
       Vec<RowFlags>& rflags = constraintMatrix.getRowFlags();
       const Vec<int>& rowsize = constraintMatrix.getRowSizes();
 
-      msg.info( "\nstarting presolve of problem {}:\n", problem.getName() );
+      if( checkpoint != nullptr )
+         msg.info( "\nresuming presolve of problem {} after round {}:\n",
+                   problem.getName(), stats.nrounds );
+      else
+         msg.info( "\nstarting presolve of problem {}:\n", problem.getName() );
       msg.info( "  rows:     {}\n", problem.getNRows() );
       msg.info( "  columns:  {}\n", problem.getNCols() );
       msg.info( "  int. columns:  {}\n", problem.getNumIntegralCols() );
@@ -424,8 +705,19 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
 
       PresolveResult<REAL> result;
 
-      result.postsolve =
-          PostsolveStorage<REAL>( problem, num, presolveOptions );
+      if( checkpoint != nullptr )
+      {
+         result.postsolve = std::move( checkpoint->postsolve );
+         result.postsolve.presolveOptions = presolveOptions;
+      }
+      else
+         result.postsolve =
+             PostsolveStorage<REAL>( problem, num, presolveOptions );
+      if( checkpoint == nullptr && !part_origcol_mapping.empty() )
+      {
+         result.postsolve.origcol_mapping = part_origcol_mapping;
+         result.postsolve.origrow_mapping = part_origrow_mapping;
+      }
 
 #ifndef PAPILO_TBB
       if( presolveOptions.threads != 1 )
@@ -447,13 +739,25 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
             return result;
          }
       }
-      if(presolveOptions.verification_with_VeriPB &&
-          problem.test_problem_type( ProblemFlag::kBinary ))
+      if( checkpoint == nullptr && presolveOptions.component_presolve &&
+          apply_componentwise( problem, timer, result, delta ) )
+         return result;
+      warmstartparts.clear();
+
+      if( checkpoint != nullptr && presolveOptions.verification_with_VeriPB )
+         msg.warn( "a VeriPB certificate can not be continued from a "
+                   "checkpoint\n" );
+
+      if( checkpoint == nullptr && presolveOptions.verification_with_VeriPB &&
+          problem.test_problem_type( ProblemFlag::kBinary ) )
       {
          certificate_interface = std::unique_ptr<CertificateInterface<REAL>>(
              new VeriPb<REAL>{ problem, num, presolveOptions } );
          certificate_interface->print_header();
       }
+      else
+         certificate_interface = std::unique_ptr<CertificateInterface<REAL>>(
+             new EmptyCertificate<REAL>() );
 
       result.status = PresolveStatus::kUnchanged;
 
@@ -489,12 +793,23 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
                  PresolverTiming::kExhaustive )
          ++exhaustivePresolvers.second;
 
+#ifdef PAPILO_ROUND_ARENA
+      reductions.clear();
+      roundArena.reset();
+      reductions.resize( presolvers.size(), Reductions<REAL>( &roundArena ) );
+#else
       reductions.resize( presolvers.size() );
+#endif
       results.resize( presolvers.size() );
+      changesAtLastRun.clear();
+      changesAtLastRun.resize( presolvers.size(), -1 );
+      adaptiveSelection.resize( static_cast<int>( presolvers.size() ) );
+      initialwork = count_work();
+      presolvework = 0.0;
 
       round_to_evaluate = Delegator::kFast;
 
-      presolverStats.resize( presolvers.size(), std::pair<int, int>( 0, 0 ) );
+      presolverStats.assign( presolvers.size(), std::pair<int, int>( 0, 0 ) );
 
       ProblemUpdate<REAL> probUpdate( problem, result.postsolve, stats,
                                       presolveOptions, num, msg, certificate_interface
@@ -509,32 +824,55 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
          }
       }
 
-      result.status = probUpdate.trivialPresolve();
-
-      if( result.status == PresolveStatus::kInfeasible ||
-          result.status == PresolveStatus::kUnbndOrInfeas ||
-          result.status == PresolveStatus::kUnbounded )
+      if( checkpoint != nullptr )
       {
-         probUpdate.getCertificateInterface()->infeasible();
-         return result;
+         probUpdate.restoreCheckpoint( std::move( checkpoint->problemUpdate ) );
+         restoreCheckpoint( *checkpoint );
       }
-      printRoundStats( false, "Trivial" );
-      round_to_evaluate = Delegator::kFast;
+      else
+      {
+         result.status = probUpdate.trivialPresolve();
 
-      finishRound( probUpdate );
-      ++stats.nrounds;
+         if( result.status == PresolveStatus::kInfeasible ||
+             result.status == PresolveStatus::kUnbndOrInfeas ||
+             result.status == PresolveStatus::kUnbounded )
+         {
+            probUpdate.getCertificateInterface()->infeasible();
+            return result;
+         }
+         printRoundStats( false, "Trivial" );
+         round_to_evaluate = Delegator::kFast;
+
+         finishRound( probUpdate );
+         ++stats.nrounds;
+      }
+
+      if( presolveOptions.detect_blocks )
+      {
+         probUpdate.detectBlockStructure();
+         const BlockStructure& blocks = probUpdate.getBlockStructure();
+         if( blocks.hasBlocks() )
+            msg.info( "detected {} blocks with {} linking rows and {} linking "
+                      "columns\n",
+                      blocks.getNBlocks(), blocks.getNLinkingRows(),
+                      blocks.getNLinkingCols() );
+      }
 
-      nunsuccessful = 0;
-      rundelayed = true;
-      for( int i = 0; i < npresolvers; ++i )
+      if( checkpoint == nullptr )
       {
-         if( presolvers[i]->isEnabled() && presolvers[i]->isDelayed() )
+         nunsuccessful = 0;
+         rundelayed = true;
+         for( int i = 0; i < npresolvers; ++i )
          {
-            rundelayed = false;
-            break;
+            if( presolvers[i]->isEnabled() && presolvers[i]->isDelayed() )
+            {
+               rundelayed = false;
+               break;
+            }
          }
       }
 
+      double lastcheckpoint = 0.0;
       Statistics last_rounds_stats = stats;
       do
       {
@@ -569,6 +907,26 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
             return result;
          last_rounds_stats = stats;
 
+         if( checkpointHandler && round_to_evaluate != Delegator::kAbort &&
+             timer.getTime() - lastcheckpoint >=
+                 presolveOptions.checkpointinterval )
+         {
+            checkpointHandler( createCheckpoint( problem, result.postsolve,
+                                                 probUpdate, timer ) );
+            lastcheckpoint = timer.getTime();
+         }
+
+         if( progressCallback && round_to_evaluate != Delegator::kAbort &&
+             progressCallback( createProgress( problem, probUpdate ) ) )
+            interrupt();
+
+         if( round_to_evaluate != Delegator::kAbort && isInterrupted() )
+         {
+            msg.info( "presolve interrupted after round {}\n",
+                      stats.nrounds );
+            round_to_evaluate = Delegator::kAbort;
+         }
+
       } while( round_to_evaluate != Delegator::kAbort );
 
       if( stats.ntsxapplied > 0 || stats.nboundchgs > 0 ||
@@ -977,6 +1335,383 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
 #endif
 }
 
+/***
+ * presolves the disconnected components of the problem independently and in
+ * parallel. Components are grouped into parts with at least componentminnnz
+ * nonzeros, each part is presolved by its own Presolve instance with the
+ * presolvers and parameters of this one. Afterwards the reduced parts are
+ * merged into the reduced problem and their postsolve information is appended
+ * to the postsolve storage of the original problem.
+ * If presolve.warmstart is set, the presolved parts are kept and the parts
+ * that are equal to a kept part and not modified by the delta are reused
+ * instead of presolving them again.
+ *
+ * @return: false if the problem was not presolved componentwise, i.e., it
+ * has only one part or the settings do not allow it
+ */
+template <typename REAL>
+bool
+Presolve<REAL>::apply_componentwise( Problem<REAL>& problem,
+                                     const Timer& timer,
+                                     PresolveResult<REAL>& result,
+                                     const ProblemDelta<REAL>* delta )
+{
+   Vec<WarmstartPart> previousparts = std::move( warmstartparts );
+   warmstartparts.clear();
+
+   if( problem.getNCols() == 0 )
+      return false;
+
+   if( result.postsolve.postsolveType == PostsolveType::kFull ||
+       presolveOptions.verification_with_VeriPB )
+   {
+      msg.info( "component presolve is only available for primal postsolve "
+                "without certificate, presolving the problem as a whole\n" );
+      return false;
+   }
+
+   // the parts are presolved by the default presolvers with the parameters of
+   // this instance, hence other presolvers can not be used
+   Presolve<REAL> defaultPresolve;
+   defaultPresolve.addDefaultPresolvers();
+   for( const auto& presolver : presolvers )
+   {
+      if( std::none_of( defaultPresolve.presolvers.begin(),
+                        defaultPresolve.presolvers.end(),
+                        [&presolver]( const auto& other ) {
+                           return other->getName() == presolver->getName();
+                        } ) )
+      {
+         msg.info( "component presolve does not support presolver {}, "
+                   "presolving the problem as a whole\n",
+                   presolver->getName() );
+         return false;
+      }
+   }
+
+   Components components;
+   int ncomponents = components.detectComponents( problem );
+
+   if( ncomponents <= 1 )
+      return false;
+
+   // group consecutive components into parts of at least componentminnnz
+   // nonzeros
+   const Vec<int>& colsizes = problem.getColSizes();
+   Vec<Vec<int>> partcols( 1 );
+   Vec<Vec<int>> partrows( 1 );
+   int nnz = 0;
+
+   for( int c = 0; c != ncomponents; ++c )
+   {
+      const int* compcols = components.getComponentsCols( c );
+      const int* comprows = components.getComponentsRows( c );
+      int numcompcols = components.getComponentsNumCols( c );
+      int numcomprows = components.getComponentsNumRows( c );
+
+      for( int j = 0; j != numcompcols; ++j )
+      {
+         partcols.back().push_back( compcols[j] );
+         nnz += colsizes[compcols[j]];
+      }
+      partrows.back().insert( partrows.back().end(), comprows,
+                              comprows + numcomprows );
+
+      if( nnz >= presolveOptions.componentminnnz && c != ncomponents - 1 )
+      {
+         partcols.emplace_back();
+         partrows.emplace_back();
+         nnz = 0;
+      }
+   }
+
+   int nparts = static_cast<int>( partcols.size() );
+
+   if( nparts <= 1 )
+      return false;
+
+   msg.info( "presolving {} disconnected components in {} parts\n",
+             ncomponents, nparts );
+
+   Vec<int> col2local( problem.getNCols() );
+   for( int p = 0; p != nparts; ++p )
+   {
+      std::sort( partcols[p].begin(), partcols[p].end() );
+      std::sort( partrows[p].begin(), partrows[p].end() );
+
+      for( int k = 0; k != static_cast<int>( partcols[p].size() ); ++k )
+         col2local[partcols[p][k]] = k;
+   }
+
+   // the components only depend on the structure of the matrix, hence a
+   // kept part that has the same rows and columns is still valid if the
+   // delta does not modify it
+   Vec<uint8_t> reuse( nparts, false );
+   if( delta != nullptr &&
+       static_cast<int>( previousparts.size() ) == nparts )
+   {
+      Vec<uint8_t> modifiedrows( problem.getNRows(), false );
+      Vec<uint8_t> modifiedcols( problem.getNCols(), false );
+      delta->markModified( modifiedrows, modifiedcols );
+
+      int nreused = 0;
+      for( int p = 0; p != nparts; ++p )
+      {
+         reuse[p] =
+             previousparts[p].rows == partrows[p] &&
+             previousparts[p].cols == partcols[p] &&
+             std::none_of( partrows[p].begin(), partrows[p].end(),
+                           [&]( int row ) { return modifiedrows[row]; } ) &&
+             std::none_of( partcols[p].begin(), partcols[p].end(),
+                           [&]( int col ) { return modifiedcols[col]; } );
+         if( reuse[p] )
+            ++nreused;
+      }
+      msg.info( "reusing {} of {} presolved parts\n", nreused, nparts );
+   }
+
+   Vec<Problem<REAL>> partproblems( nparts );
+   Vec<PresolveResult<REAL>> partresults( nparts );
+   Vec<Statistics> partstats( nparts );
+   ParameterSet paramSet = getParameters();
+
+   auto presolve_part = [&]( int p ) {
+      if( reuse[p] )
+      {
+         partproblems[p] = std::move( previousparts[p].reduced );
+         partresults[p] = std::move( previousparts[p].result );
+         partstats[p] = previousparts[p].stats;
+         return;
+      }
+
+      int partnnz = 0;
+      for( int col : partcols[p] )
+         partnnz += colsizes[col];
+
+      ProblemBuilder<REAL> builder;
+      builder.reserve( partnnz, static_cast<int>( partrows[p].size() ),
+                       static_cast<int>( partcols[p].size() ) );
+      builder.setNumCols( static_cast<int>( partcols[p].size() ) );
+      builder.setNumRows( static_cast<int>( partrows[p].size() ) );
+      add_to_builder( builder, problem, partrows[p], partcols[p], col2local,
+                      0 );
+      builder.setProblemName( problem.getName() );
+      partproblems[p] = builder.build();
+
+      Presolve<REAL> presolve;
+      presolve.addDefaultPresolvers();
+      presolve.setPresolverOptions( presolveOptions );
+      presolve.getParameters().copyValues( paramSet );
+      for( auto& presolver : presolve.presolvers )
+      {
+         if( std::none_of( presolvers.begin(), presolvers.end(),
+                           [&presolver]( const auto& other ) {
+                              return other->getName() == presolver->getName();
+                           } ) )
+            presolver->setEnabled( false );
+      }
+      presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+      presolve.presolveOptions.threads = 1;
+      presolve.presolveOptions.component_presolve = false;
+      if( presolveOptions.tlim != std::numeric_limits<double>::max() )
+         presolve.presolveOptions.tlim =
+             std::max( presolveOptions.tlim - timer.getTime(), 0.0 );
+      presolve.part_origrow_mapping = partrows[p];
+      presolve.part_origcol_mapping = partcols[p];
+      presolve.interruptflag = interruptflag;
+
+      partresults[p] = presolve.apply( partproblems[p], false );
+      partstats[p] = presolve.getStatistics();
+   };
+
+#ifdef PAPILO_TBB
+   tbb::parallel_for(
+       tbb::blocked_range<int>( 0, nparts ),
+       [&]( const tbb::blocked_range<int>& r ) {
+          for( int p = r.begin(); p != r.end(); ++p )
+             presolve_part( p );
+       },
+       tbb::simple_partitioner() );
+#else
+   for( int p = 0; p != nparts; ++p )
+      presolve_part( p );
+#endif
+
+   result.status = PresolveStatus::kUnchanged;
+   for( int p = 0; p != nparts; ++p )
+   {
+      switch( partresults[p].status )
+      {
+      case PresolveStatus::kInfeasible:
+         result.status = PresolveStatus::kInfeasible;
+         break;
+      case PresolveStatus::kUnbndOrInfeas:
+      case PresolveStatus::kUnbounded:
+         if( result.status != PresolveStatus::kInfeasible )
+            result.status = PresolveStatus::kUnbndOrInfeas;
+         break;
+      case PresolveStatus::kReduced:
+         if( result.status == PresolveStatus::kUnchanged )
+            result.status = PresolveStatus::kReduced;
+         break;
+      case PresolveStatus::kUnchanged:
+         break;
+      }
+
+      stats.ntsxapplied += partstats[p].ntsxapplied;
+      stats.ntsxconflicts += partstats[p].ntsxconflicts;
+      stats.nboundchgs += partstats[p].nboundchgs;
+      stats.nsidechgs += partstats[p].nsidechgs;
+      stats.ncoefchgs += partstats[p].ncoefchgs;
+      stats.ndeletedcols += partstats[p].ndeletedcols;
+      stats.ndeletedrows += partstats[p].ndeletedrows;
+      stats.nrounds = std::max( stats.nrounds, partstats[p].nrounds );
+   }
+
+   auto keep_parts = [&]() {
+      if( !presolveOptions.warmstart )
+         return;
+      warmstartparts.resize( nparts );
+      for( int p = 0; p != nparts; ++p )
+      {
+         warmstartparts[p].rows = std::move( partrows[p] );
+         warmstartparts[p].cols = std::move( partcols[p] );
+         warmstartparts[p].reduced = std::move( partproblems[p] );
+         warmstartparts[p].result = std::move( partresults[p] );
+         warmstartparts[p].stats = partstats[p];
+      }
+   };
+
+   if( is_status_infeasible_or_unbounded( result.status ) )
+   {
+      keep_parts();
+      return true;
+   }
+
+   // merge the reduced parts and their postsolve information
+   result.postsolve.origcol_mapping.clear();
+   result.postsolve.origrow_mapping.clear();
+   int ncols = 0;
+   int nrows = 0;
+   nnz = 0;
+   for( int p = 0; p != nparts; ++p )
+   {
+      result.postsolve.append( partresults[p].postsolve );
+      ncols += partproblems[p].getNCols();
+      nrows += partproblems[p].getNRows();
+      nnz += partproblems[p].getConstraintMatrix().getNnz();
+   }
+
+   ProblemBuilder<REAL> builder;
+   builder.reserve( nnz, nrows, ncols );
+   builder.setNumCols( ncols );
+   builder.setNumRows( nrows );
+   builder.setProblemName( problem.getName() );
+
+   REAL offset = problem.getObjective().offset;
+   Vec<int> firstcol( nparts + 1, 0 );
+   Vec<int> firstrow( nparts + 1, 0 );
+   for( int p = 0; p != nparts; ++p )
+   {
+      const Problem<REAL>& part = partproblems[p];
+      Vec<int> rows( part.getNRows() );
+      Vec<int> cols( part.getNCols() );
+      Vec<int> col2new( part.getNCols() );
+      for( int k = 0; k != part.getNRows(); ++k )
+         rows[k] = k;
+      for( int k = 0; k != part.getNCols(); ++k )
+      {
+         cols[k] = k;
+         col2new[k] = firstcol[p] + k;
+      }
+      add_to_builder( builder, part, rows, cols, col2new, firstrow[p] );
+      offset += part.getObjective().offset;
+
+      firstcol[p + 1] = firstcol[p] + part.getNCols();
+      firstrow[p + 1] = firstrow[p] + part.getNRows();
+   }
+   builder.setObjOffset( offset );
+
+   Problem<REAL> reduced = builder.build();
+
+   for( int p = 0; p != nparts; ++p )
+   {
+      for( const Symmetry& symmetry :
+           partproblems[p].getSymmetries().symmetries )
+         reduced.getSymmetries().addSymmetry(
+             firstcol[p] + symmetry.getDominatingCol(),
+             firstcol[p] + symmetry.getDominatedCol(),
+             symmetry.getSymmetryType() );
+   }
+
+   // names are not compressed during presolve but accessed by the original
+   // indices
+   reduced.setVariableNames( problem.getVariableNames() );
+   reduced.setConstraintNames( problem.getConstraintNames() );
+   for( ProblemFlag flag :
+        { ProblemFlag::kMixedInteger, ProblemFlag::kInteger,
+          ProblemFlag::kLinear, ProblemFlag::kBinary } )
+   {
+      if( problem.test_problem_type( flag ) )
+         reduced.set_problem_type( flag );
+   }
+   reduced.recomputeAllActivities();
+   reduced.recomputeLocks();
+
+   problem = std::move( reduced );
+   keep_parts();
+
+   msg.info( "component presolve finished: {} rows, {} columns, {} "
+             "nonzeros\n",
+             problem.getNRows(), problem.getNCols(),
+             problem.getConstraintMatrix().getNnz() );
+
+   return true;
+}
+
+/// adds the given rows and columns of the problem to the builder, the
+/// columns are placed at the indices given by col2new and the rows
+/// consecutively starting at firstrow. The flags are copied exactly.
+template <typename REAL>
+void
+Presolve<REAL>::add_to_builder( ProblemBuilder<REAL>& builder,
+                                const Problem<REAL>& problem,
+                                const Vec<int>& rows, const Vec<int>& cols,
+                                const Vec<int>& col2new, int firstrow ) const
+{
+   const ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+   const Vec<REAL>& obj = problem.getObjective().coefficients;
+   const Vec<REAL>& lbs = problem.getLowerBounds();
+   const Vec<REAL>& ubs = problem.getUpperBounds();
+   const Vec<REAL>& lhs = consMatrix.getLeftHandSides();
+   const Vec<REAL>& rhs = consMatrix.getRightHandSides();
+   const Vec<ColFlags>& cflags = problem.getColFlags();
+   const Vec<RowFlags>& rflags = problem.getRowFlags();
+
+   for( int col : cols )
+   {
+      int newcol = col2new[col];
+      builder.setObj( newcol, obj[col] );
+      builder.setColLb( newcol, lbs[col] );
+      builder.setColUb( newcol, ubs[col] );
+      builder.setColFlags( newcol, cflags[col] );
+   }
+
+   for( int k = 0; k != static_cast<int>( rows.size() ); ++k )
+   {
+      int row = rows[k];
+      builder.setRowLhs( firstrow + k, lhs[row] );
+      builder.setRowRhs( firstrow + k, rhs[row] );
+      builder.setRowFlags( firstrow + k, rflags[row] );
+
+      auto rowvec = consMatrix.getRowCoefficients( row );
+      const int* inds = rowvec.getIndices();
+      const REAL* vals = rowvec.getValues();
+      for( int i = 0; i != rowvec.getLength(); ++i )
+         builder.addEntry( firstrow + k, col2new[inds[i]], vals[i] );
+   }
+}
+
 template <typename REAL>
 void
 Presolve<REAL>::run_presolvers( const Problem<REAL>& problem,
@@ -987,6 +1722,15 @@ Presolve<REAL>::run_presolvers( const Problem<REAL>& problem,
 #ifndef PAPILO_TBB
    assert(presolveOptions.runs_sequential() == true);
 #endif
+   if( presolveOptions.adaptive_selection )
+      select_presolvers( presolver_2_run, timer );
+
+   if( presolveOptions.worklim != std::numeric_limits<double>::max() )
+   {
+      for( auto& presolver : presolvers )
+         presolver->setWorkBudget( presolveOptions.worklim - presolvework );
+   }
+
    if( presolveOptions.runs_sequential() &&
        presolveOptions.apply_results_immediately_if_run_sequentially )
    {
@@ -1013,6 +1757,9 @@ Presolve<REAL>::run_presolvers( const Problem<REAL>& problem,
       probUpdate.check_and_compress();
    }
 #ifdef PAPILO_TBB
+   else if( presolveOptions.concurrent_rounds )
+      run_presolvers_concurrently( problem, presolver_2_run, probUpdate,
+                                   timer );
    else
    {
       int cause = -1;
@@ -1036,6 +1783,124 @@ Presolve<REAL>::run_presolvers( const Problem<REAL>& problem,
 #endif
 }
 
+#ifdef PAPILO_TBB
+template <typename REAL>
+void
+Presolve<REAL>::run_presolvers_concurrently(
+    const Problem<REAL>& problem, const std::pair<int, int>& presolver_2_run,
+    ProblemUpdate<REAL>& probUpdate, const Timer& timer )
+{
+   // the presolvers of lower timing classes depend on the reductions applied
+   // since their last call, so they are only scheduled again if the problem
+   // changed in the meantime. All scheduled presolvers read the same problem
+   // and their reductions are applied in the order of the presolvers at the
+   // round barrier, independent of the order in which the tasks finish.
+   const int64_t nchanges = count_changes();
+
+   scheduledPresolvers.clear();
+   for( int i = 0; i != presolver_2_run.first; ++i )
+   {
+      if( changesAtLastRun[i] != nchanges )
+         scheduledPresolvers.push_back( i );
+   }
+   for( int i = presolver_2_run.first; i != presolver_2_run.second; ++i )
+      scheduledPresolvers.push_back( i );
+
+   for( int i : scheduledPresolvers )
+      changesAtLastRun[i] = nchanges;
+
+   // every presolver is a task of its own, so that idle threads can take
+   // over the remaining presolvers while a long running one is busy
+   tbb::parallel_for(
+       tbb::blocked_range<int>( 0, (int) scheduledPresolvers.size(), 1 ),
+       [&]( const tbb::blocked_range<int>& r ) {
+          for( int k = r.begin(); k != r.end(); ++k )
+          {
+             int i = scheduledPresolvers[k];
+             int cause = -1;
+             results[i] = presolvers[i]->run( problem, probUpdate, num,
+                                              reductions[i], timer, cause );
+             if( results[i] == PresolveStatus::kInfeasible &&
+                 presolvers[i]->getName() == "probing" )
+             {
+                assert( cause != -1 );
+                probUpdate.getCertificateInterface()->setInfeasibleCause(
+                    cause );
+             }
+          }
+       },
+       tbb::simple_partitioner() );
+}
+#endif
+
+template <typename REAL>
+void
+Presolve<REAL>::select_presolvers( const std::pair<int, int>& presolver_2_run,
+                                   const Timer& timer )
+{
+   const double elapsed = timer.getTime();
+   if( stats.ntsxapplied == 0 || elapsed <= 0.0 )
+      return;
+
+   // number of applied transactions per second of the whole presolve so far
+   const double overallrate = stats.ntsxapplied / elapsed;
+   const double inf = std::numeric_limits<double>::max();
+   const double remainingtime =
+       presolveOptions.tlim == inf ? inf : presolveOptions.tlim - elapsed;
+   const double remainingwork = presolveOptions.worklim == inf
+                                    ? inf
+                                    : presolveOptions.worklim - presolvework;
+
+   Vec<int> candidates;
+   for( int i = presolver_2_run.first; i != presolver_2_run.second; ++i )
+   {
+      PresolveMethod<REAL>& presolver = *presolvers[i];
+      adaptiveSelection.update( i, presolver.getNCalls(),
+                                presolver.getExecTime(), presolver.getWork(),
+                                presolverStats[i].second );
+
+      // fast presolvers are cheap and needed for the round logic, and every
+      // presolver needs a few calls before its payoff can be predicted
+      if( presolver.getTiming() == PresolverTiming::kFast ||
+          !presolver.isEnabled() || presolver.isDelayed() ||
+          presolver.isSkipped() || !adaptiveSelection.isPredictable( i ) )
+         continue;
+
+      candidates.push_back( i );
+   }
+
+   if( candidates.empty() )
+      return;
+
+   Vec<int> skiprounds = adaptiveSelection.select(
+       candidates, presolveOptions.adaptivefac * overallrate, remainingtime,
+       remainingwork );
+
+   for( int k = 0; k != static_cast<int>( candidates.size() ); ++k )
+   {
+      if( skiprounds[k] == 0 )
+         continue;
+
+      PresolveMethod<REAL>& presolver = *presolvers[candidates[k]];
+      const PresolverEstimate& estimate =
+          adaptiveSelection.getEstimate( candidates[k] );
+      presolver.skipRounds( skiprounds[k] );
+      msg.detailed( "skipping presolver {} for {} rounds (predicted {:.1f} "
+                    "reductions in {:.3f} seconds, overall {:.1f} per "
+                    "second)\n",
+                    presolver.getName(), skiprounds[k], estimate.reductions,
+                    estimate.time, overallrate );
+   }
+}
+
+template <typename REAL>
+int64_t
+Presolve<REAL>::count_changes() const
+{
+   return int64_t{ stats.ntsxapplied } + stats.nboundchgs + stats.nsidechgs +
+          stats.ncoefchgs + stats.ndeletedcols + stats.ndeletedrows;
+}
+
 template <typename REAL>
 void
 Presolve<REAL>::apply_result_sequential( int index_presolver,
@@ -1061,7 +1926,9 @@ Presolve<REAL>::determine_next_round( Problem<REAL>& problem,
                                       const Timer& presolvetimer,
                                       bool unchanged )
 {
-   if( is_time_exceeded( presolvetimer ) )
+   presolvework = count_work() - initialwork;
+   if( is_time_exceeded( presolvetimer ) || is_work_exceeded() ||
+       isInterrupted() )
       return Delegator::kAbort;
 
    Delegator next_round = increase_round_if_last_run_was_not_successfull(
@@ -1188,6 +2055,28 @@ template <typename REAL>
 std::pair<int, int>
 Presolve<REAL>::applyReductions( int p, const Reductions<REAL>& reductions_,
                                  ProblemUpdate<REAL>& probUpdate )
+{
+   // the deferred activity updates are processed in parallel but in the same
+   // order per row, so the result does not depend on this option
+   const bool defer = presolveOptions.parallel_apply &&
+                      !presolveOptions.runs_sequential() &&
+                      !presolveOptions.verification_with_VeriPB;
+
+   if( defer )
+      probUpdate.setDeferActivityUpdates( true );
+
+   auto statistics = apply_transactions( p, reductions_, probUpdate );
+
+   if( defer )
+      probUpdate.setDeferActivityUpdates( false );
+
+   return statistics;
+}
+
+template <typename REAL>
+std::pair<int, int>
+Presolve<REAL>::apply_transactions( int p, const Reductions<REAL>& reductions_,
+                                    ProblemUpdate<REAL>& probUpdate )
 {
    int k = 0;
    ApplyResult result;
@@ -1284,6 +2173,84 @@ Presolve<REAL>::applyPostponed( ProblemUpdate<REAL>& probUpdate )
    postponedReductionToPresolver.clear();
 }
 
+template <typename REAL>
+PresolveProgress
+Presolve<REAL>::createProgress( const Problem<REAL>& problem,
+                                const ProblemUpdate<REAL>& probUpdate ) const
+{
+   PresolveProgress progress;
+   progress.stats = stats;
+   progress.nactiverows = probUpdate.getNActiveRows();
+   progress.nactivecols = probUpdate.getNActiveCols();
+   progress.nnz = problem.getConstraintMatrix().getNnz();
+   progress.presolvers.reserve( presolvers.size() );
+   for( const auto& presolver : presolvers )
+      progress.presolvers.push_back(
+          PresolverProgress{ presolver->getName(), presolver->getNCalls(),
+                             presolver->getExecTime(),
+                             presolver->getWork() } );
+   return progress;
+}
+
+template <typename REAL>
+PresolveCheckpoint<REAL>
+Presolve<REAL>::createCheckpoint( const Problem<REAL>& problem,
+                                  const PostsolveStorage<REAL>& postsolve,
+                                  const ProblemUpdate<REAL>& probUpdate,
+                                  const Timer& timer ) const
+{
+   PresolveCheckpoint<REAL> checkpoint;
+   checkpoint.problem = problem;
+   checkpoint.postsolve = postsolve;
+   checkpoint.stats = stats;
+   checkpoint.stats.presolvetime += timer.getTime();
+   probUpdate.saveCheckpoint( checkpoint.problemUpdate );
+
+   checkpoint.presolvers.resize( presolvers.size() );
+   for( std::size_t i = 0; i != presolvers.size(); ++i )
+      presolvers[i]->saveCheckpoint( checkpoint.presolvers[i] );
+
+   checkpoint.presolverStats = presolverStats;
+   checkpoint.changesAtLastRun = changesAtLastRun;
+   checkpoint.adaptiveestimates = adaptiveSelection.getEstimates();
+   checkpoint.presolvework = presolvework;
+   checkpoint.nextround = static_cast<int>( round_to_evaluate );
+   checkpoint.lastRoundReduced = lastRoundReduced;
+   checkpoint.nunsuccessful = nunsuccessful;
+   checkpoint.rundelayed = rundelayed;
+
+   return checkpoint;
+}
+
+template <typename REAL>
+void
+Presolve<REAL>::restoreCheckpoint( const PresolveCheckpoint<REAL>& checkpoint )
+{
+   // resume() checked that the checkpoint contains the same presolvers,
+   // which are matched by name since they may have been added in another order
+   for( std::size_t i = 0; i != presolvers.size(); ++i )
+   {
+      for( std::size_t k = 0; k != checkpoint.presolvers.size(); ++k )
+      {
+         if( checkpoint.presolvers[k].name != presolvers[i]->getName() )
+            continue;
+
+         presolvers[i]->restoreCheckpoint( checkpoint.presolvers[k] );
+         presolverStats[i] = checkpoint.presolverStats[k];
+         changesAtLastRun[i] = checkpoint.changesAtLastRun[k];
+         adaptiveSelection.getEstimates()[i] =
+             checkpoint.adaptiveestimates[k];
+         break;
+      }
+   }
+
+   presolvework = checkpoint.presolvework;
+   round_to_evaluate = static_cast<Delegator>( checkpoint.nextround );
+   lastRoundReduced = checkpoint.lastRoundReduced;
+   nunsuccessful = checkpoint.nunsuccessful;
+   rundelayed = checkpoint.rundelayed;
+}
+
 template <typename REAL>
 void
 Presolve<REAL>::finishRound( ProblemUpdate<REAL>& probUpdate )
@@ -1291,8 +2258,16 @@ Presolve<REAL>::finishRound( ProblemUpdate<REAL>& probUpdate )
    probUpdate.clearStates();
    probUpdate.check_and_compress();
 
+#ifdef PAPILO_ROUND_ARENA
+   // the reductions of the round are no longer referenced, so that the memory
+   // of the arena can be recycled for the next round
+   for( auto& reduction : reductions )
+      reduction.release();
+   roundArena.reset();
+#else
    for( auto& reduction : reductions )
       reduction.clear();
+#endif
 
    std::fill( results.begin(), results.end(), PresolveStatus::kUnchanged );
 }
@@ -1331,6 +2306,24 @@ Presolve<REAL>::is_time_exceeded( const Timer& presolvetimer ) const
           presolvetimer.getTime() >= presolveOptions.tlim;
 }
 
+template <typename REAL>
+double
+Presolve<REAL>::count_work() const
+{
+   double work = 0.0;
+   for( const auto& presolver : presolvers )
+      work += presolver->getWork();
+   return work;
+}
+
+template <typename REAL>
+bool
+Presolve<REAL>::is_work_exceeded() const
+{
+   return presolveOptions.worklim != std::numeric_limits<double>::max() &&
+          presolvework >= presolveOptions.worklim;
+}
+
 template <typename REAL>
 bool
 Presolve<REAL>::are_applied_tsx_negligible( const Problem<REAL>& problem,
@@ -1455,6 +2448,14 @@ Presolve<REAL>::printPresolversStats()
       presolvers[i]->printStats( msg, presolverStats[i] );
    }
 
+   msg.info( "\npresolve work: {:.0f} units\n", presolvework );
+
+#ifdef PAPILO_ROUND_ARENA
+   msg.info( "allocator: {}, round arena peak: {:.1f} MB\n",
+             getAllocatorName(), roundArena.getPeakBytes() / 1048576.0 );
+#else
+   msg.info( "allocator: {}\n", getAllocatorName() );
+#endif
    msg.info( "\n" );
 }
 
@@ -1464,7 +2465,9 @@ Presolve<REAL>::logStatus( ProblemUpdate<REAL>& problem_update,
                            const PostsolveStorage<REAL>& postsolveStorage ) const
 {
    Problem<REAL>& problem = problem_update.getProblem();
-   if( problem.getNCols() == 0)
+   // parts of a problem that is presolved componentwise can not be
+   // postsolved on their own
+   if( problem.getNCols() == 0 && part_origcol_mapping.empty() )
    {
       // the primal dual can be disabled therefore calculate only primal for obj
       Solution<REAL> solution{};
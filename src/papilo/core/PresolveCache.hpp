@@ -0,0 +1,262 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_PRESOLVE_CACHE_HPP_
+#define _PAPILO_CORE_PRESOLVE_CACHE_HPP_
+
+#include "papilo/core/Presolve.hpp"
+#include "papilo/core/Problem.hpp"
+#include "papilo/core/postsolve/PostsolveStorage.hpp"
+#include "papilo/misc/Hash.hpp"
+#include "papilo/misc/ParameterSet.hpp"
+#include "papilo/misc/ProblemFingerprint.hpp"
+#include "papilo/misc/fmt.hpp"
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+#include <utility>
+
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <cstdio>
+#include <fstream>
+#endif
+
+namespace papilo
+{
+
+/// identifies a presolve result by the fingerprint of the original problem
+/// and the settings presolve ran with
+struct PresolveCacheKey
+{
+   uint64_t fingerprint = 0;
+   uint64_t settingshash = 0;
+   /// the parameter values and the arithmetic, compared on lookup to rule out
+   /// hash collisions
+   String settings;
+};
+
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
+
+/// identifies cache files and their format
+const static int PRESOLVE_CACHE_FORMAT = 1;
+
+/// on-disk cache of presolve results. The entries are found by the
+/// fingerprint of the original problem and the hash of the settings. An
+/// entry is only used if the original problem stored with its postsolve
+/// information equals the given problem, since the postsolve mappings refer
+/// to the order of its rows and columns.
+template <typename REAL>
+class PresolveCache
+{
+ public:
+   explicit PresolveCache( std::string _directory )
+       : directory( std::move( _directory ) )
+   {
+   }
+
+   /// computes the key of the problem, must be called before presolve
+   /// modifies the problem. The parameters contain the presolve options and
+   /// the parameters of the presolvers.
+   PresolveCacheKey
+   computeKey( const Problem<REAL>& problem, ParameterSet& parameters,
+               bool store_dual_postsolve ) const
+   {
+      PresolveCacheKey key;
+      parameters.printParams( std::back_inserter( key.settings ) );
+      key.settings += fmt::format( "\nstore_dual_postsolve = {}\nreal = {}\n",
+                                   store_dual_postsolve, typeid( REAL ).name() );
+
+      Hasher<uint64_t> hasher( key.settings.size() );
+      for( char c : key.settings )
+         hasher.addValue( static_cast<unsigned char>( c ) );
+
+      key.settingshash = hasher.getHash();
+      key.fingerprint = compute_problem_fingerprint( problem );
+      return key;
+   }
+
+   /// loads the result of presolving the given problem and replaces the
+   /// problem by the reduced problem. Returns an empty optional if there is
+   /// no matching entry.
+   boost::optional<PresolveResult<REAL>>
+   load( const PresolveCacheKey& key, Problem<REAL>& problem ) const
+   {
+      std::ifstream ifs( getFilename( key ), std::ios_base::binary );
+      if( !ifs )
+         return boost::none;
+
+      PresolveResult<REAL> result;
+      Problem<REAL> reduced;
+      try
+      {
+         boost::archive::binary_iarchive ia( ifs );
+         int format = 0;
+         ia >> format;
+         if( format != PRESOLVE_CACHE_FORMAT )
+            return boost::none;
+
+         String settings;
+         ia >> settings;
+         if( settings != key.settings )
+            return boost::none;
+
+         int status = 0;
+         ia >> status;
+         result.status = static_cast<PresolveStatus>( status );
+         ia >> reduced;
+         ia >> result.postsolve;
+      }
+      catch( const boost::archive::archive_exception& )
+      {
+         return boost::none;
+      }
+
+      if( !isSameProblem( result.postsolve.getOriginalProblem(), problem ) )
+         return boost::none;
+
+      problem = std::move( reduced );
+      return result;
+   }
+
+   /// stores the reduced problem and the presolve result under the key of
+   /// the original problem. The entry is written to a temporary file that
+   /// replaces the entry afterwards, so readers never see a partial entry.
+   bool
+   store( const PresolveCacheKey& key, const Problem<REAL>& reduced,
+          const PresolveResult<REAL>& result ) const
+   {
+      std::string filename = getFilename( key );
+      std::string tmpfilename = filename + ".tmp";
+      {
+         std::ofstream ofs( tmpfilename, std::ios_base::binary );
+         if( !ofs )
+            return false;
+
+         boost::archive::binary_oarchive oa( ofs );
+         oa << PRESOLVE_CACHE_FORMAT;
+         oa << key.settings;
+         oa << static_cast<int>( result.status );
+         oa << reduced;
+         oa << result.postsolve;
+
+         if( !ofs )
+            return false;
+      }
+
+      return std::rename( tmpfilename.c_str(), filename.c_str() ) == 0;
+   }
+
+   std::string
+   getFilename( const PresolveCacheKey& key ) const
+   {
+      return fmt::format( "{}/{:016x}-{:016x}.presolve", directory,
+                          key.fingerprint, key.settingshash );
+   }
+
+   /// returns true if the problems have the same rows and columns in the
+   /// same order
+   static bool
+   isSameProblem( const Problem<REAL>& problem1, const Problem<REAL>& problem2 )
+   {
+      const ConstraintMatrix<REAL>& matrix1 = problem1.getConstraintMatrix();
+      const ConstraintMatrix<REAL>& matrix2 = problem2.getConstraintMatrix();
+      const int nrows = problem1.getNRows();
+      const int ncols = problem1.getNCols();
+
+      if( nrows != problem2.getNRows() || ncols != problem2.getNCols() ||
+          matrix1.getNnz() != matrix2.getNnz() ||
+          problem1.getObjective().offset != problem2.getObjective().offset ||
+          problem1.getVariableNames() != problem2.getVariableNames() ||
+          problem1.getConstraintNames() != problem2.getConstraintNames() )
+         return false;
+
+      const Vec<ColFlags>& cflags1 = problem1.getColFlags();
+      const Vec<ColFlags>& cflags2 = problem2.getColFlags();
+
+      for( int col = 0; col != ncols; ++col )
+      {
+         for( ColFlag flag :
+              { ColFlag::kLbInf, ColFlag::kUbInf, ColFlag::kIntegral } )
+         {
+            if( cflags1[col].test( flag ) != cflags2[col].test( flag ) )
+               return false;
+         }
+
+         if( problem1.getObjective().coefficients[col] !=
+                 problem2.getObjective().coefficients[col] ||
+             ( !cflags1[col].test( ColFlag::kLbInf ) &&
+               problem1.getLowerBounds()[col] !=
+                   problem2.getLowerBounds()[col] ) ||
+             ( !cflags1[col].test( ColFlag::kUbInf ) &&
+               problem1.getUpperBounds()[col] !=
+                   problem2.getUpperBounds()[col] ) )
+            return false;
+      }
+
+      const Vec<RowFlags>& rflags1 = matrix1.getRowFlags();
+      const Vec<RowFlags>& rflags2 = matrix2.getRowFlags();
+
+      for( int row = 0; row != nrows; ++row )
+      {
+         for( RowFlag flag : { RowFlag::kLhsInf, RowFlag::kRhsInf } )
+         {
+            if( rflags1[row].test( flag ) != rflags2[row].test( flag ) )
+               return false;
+         }
+
+         if( ( !rflags1[row].test( RowFlag::kLhsInf ) &&
+               matrix1.getLeftHandSides()[row] !=
+                   matrix2.getLeftHandSides()[row] ) ||
+             ( !rflags1[row].test( RowFlag::kRhsInf ) &&
+               matrix1.getRightHandSides()[row] !=
+                   matrix2.getRightHandSides()[row] ) )
+            return false;
+
+         auto rowvec1 = matrix1.getRowCoefficients( row );
+         auto rowvec2 = matrix2.getRowCoefficients( row );
+         if( rowvec1.getLength() != rowvec2.getLength() )
+            return false;
+
+         for( int i = 0; i != rowvec1.getLength(); ++i )
+         {
+            if( rowvec1.getIndices()[i] != rowvec2.getIndices()[i] ||
+                rowvec1.getValues()[i] != rowvec2.getValues()[i] )
+               return false;
+         }
+      }
+
+      return true;
+   }
+
+ private:
+   std::string directory;
+};
+
+#endif
+
+} // namespace papilo
+
+#endif
@@ -0,0 +1,152 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_PRESOLVE_CHECKPOINT_HPP_
+#define _PAPILO_CORE_PRESOLVE_CHECKPOINT_HPP_
+
+#include "papilo/core/AdaptiveSelection.hpp"
+#include "papilo/core/CheckpointState.hpp"
+#include "papilo/core/Problem.hpp"
+#include "papilo/core/Statistics.hpp"
+#include "papilo/core/postsolve/PostsolveStorage.hpp"
+#include "papilo/misc/Vec.hpp"
+#include <boost/optional.hpp>
+#include <utility>
+
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+#include <cstdio>
+#include <fstream>
+#endif
+
+namespace papilo
+{
+
+/// snapshot of an in-flight presolve at a round boundary. Presolve::resume()
+/// continues presolving from it with the same result as if presolve had not
+/// been interrupted, provided the presolvers and parameters are the same.
+template <typename REAL>
+struct PresolveCheckpoint
+{
+   /// the partially reduced problem
+   Problem<REAL> problem;
+   /// the reductions applied so far and the original problem
+   PostsolveStorage<REAL> postsolve;
+   Statistics stats;
+   ProblemUpdateCheckpoint problemUpdate;
+   Vec<PresolverCheckpoint> presolvers;
+   Vec<std::pair<int, int>> presolverStats;
+   Vec<int64_t> changesAtLastRun;
+   Vec<PresolverEstimate> adaptiveestimates;
+   double presolvework = 0.0;
+   /// the presolvers of this timing class run in the next round
+   int nextround = 0;
+   bool lastRoundReduced = false;
+   int nunsuccessful = 0;
+   bool rundelayed = false;
+
+   template <typename Archive>
+   void
+   serialize( Archive& ar, const unsigned int version )
+   {
+      ar& problem;
+      ar& postsolve;
+      ar& stats;
+      ar& problemUpdate;
+      ar& presolvers;
+      ar& presolverStats;
+      ar& changesAtLastRun;
+      ar& adaptiveestimates;
+      ar& presolvework;
+      ar& nextround;
+      ar& lastRoundReduced;
+      ar& nunsuccessful;
+      ar& rundelayed;
+   }
+};
+
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
+
+/// identifies checkpoint files and their format
+const static int PRESOLVE_CHECKPOINT_FORMAT = 2;
+
+/// writes the checkpoint to a temporary file that replaces the given file
+/// afterwards, such that an interrupted write keeps the previous checkpoint
+template <typename REAL>
+bool
+writeCheckpoint( const PresolveCheckpoint<REAL>& checkpoint,
+                 const std::string& filename )
+{
+   std::string tmpfilename = filename + ".tmp";
+   {
+      std::ofstream ofs( tmpfilename, std::ios_base::binary );
+      if( !ofs )
+         return false;
+
+      boost::archive::binary_oarchive oa( ofs );
+      oa << PRESOLVE_CHECKPOINT_FORMAT;
+      oa << checkpoint;
+
+      if( !ofs )
+         return false;
+   }
+
+   return std::rename( tmpfilename.c_str(), filename.c_str() ) == 0;
+}
+
+/// reads a checkpoint written by writeCheckpoint(), returns an empty optional
+/// if the file is not a valid checkpoint
+template <typename REAL>
+boost::optional<PresolveCheckpoint<REAL>>
+readCheckpoint( const std::string& filename )
+{
+   std::ifstream ifs( filename, std::ios_base::binary );
+   if( !ifs )
+      return boost::none;
+
+   PresolveCheckpoint<REAL> checkpoint;
+   try
+   {
+      boost::archive::binary_iarchive ia( ifs );
+      int format = 0;
+      ia >> format;
+      if( format != PRESOLVE_CHECKPOINT_FORMAT )
+         return boost::none;
+      ia >> checkpoint;
+   }
+   catch( const boost::archive::archive_exception& )
+   {
+      return boost::none;
+   }
+
+   return checkpoint;
+}
+
+#endif
+
+} // namespace papilo
+
+#endif
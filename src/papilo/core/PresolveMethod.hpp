@@ -23,6 +23,7 @@
 #ifndef _PAPILO_CORE_PRESOLVE_METHOD_HPP_
 #define _PAPILO_CORE_PRESOLVE_METHOD_HPP_
 
+#include "papilo/core/CheckpointState.hpp"
 #include "papilo/core/PresolveOptions.hpp"
 #include "papilo/core/ConstraintMatrix.hpp"
 #include "papilo/core/Reductions.hpp"
@@ -40,7 +41,9 @@
 #endif
 
 #include "papilo/verification/ArgumentType.hpp"
+#include <atomic>
 #include <bitset>
+#include <functional>
 
 
 namespace papilo
@@ -101,6 +104,12 @@ class PresolveMethod
       enabled = true;
       skip = 0;
       nconsecutiveUnsuccessCall = 0;
+      timebudget = std::numeric_limits<double>::max();
+      calldeadline = std::numeric_limits<double>::max();
+      work = 0.0;
+      callwork = 0.0;
+      workbudget = std::numeric_limits<double>::max();
+      interruptflag = nullptr;
    }
 
    virtual ~PresolveMethod() = default;
@@ -122,6 +131,18 @@ class PresolveMethod
    {
    }
 
+   /// presolver specific state that is kept over the rounds and needs to be
+   /// restored when presolving continues from a checkpoint
+   virtual void
+   getCheckpointData( Vec<int>& data ) const
+   {
+   }
+
+   virtual void
+   setCheckpointData( const Vec<int>& data )
+   {
+   }
+
    void
    addParameters( ParameterSet& paramSet )
    {
@@ -158,6 +179,11 @@ class PresolveMethod
 
       ++ncalls;
 
+      calldeadline = timebudget == std::numeric_limits<double>::max()
+                         ? timebudget
+                         : timer.getTime() + timebudget;
+      callwork = 0.0;
+
 #ifdef PAPILO_TBB
       auto start = tbb::tick_count::now();
 #else
@@ -175,6 +201,11 @@ class PresolveMethod
                                 end- start ).count()/1000;
 #endif
 
+      // presolvers that do not report their work are charged one pass over
+      // the nonzeros of the matrix
+      if( callwork == 0.0 )
+         callwork = problem.getConstraintMatrix().getNnz();
+      work += callwork;
 
       switch( result )
       {
@@ -191,7 +222,9 @@ class PresolveMethod
          break;
       case PresolveStatus::kUnchanged:
          ++nconsecutiveUnsuccessCall;
-         if( timing != PresolverTiming::kFast )
+         // with adaptive selection Presolve decides about skipping
+         if( timing != PresolverTiming::kFast &&
+             !problemUpdate.getPresolveOptions().adaptive_selection )
             skip += nconsecutiveUnsuccessCall;
          break;
       }
@@ -249,6 +282,46 @@ class PresolveMethod
       return ncalls;
    }
 
+   double
+   getExecTime() const
+   {
+      return execTime;
+   }
+
+   /// returns the deterministic work of all calls in work units
+   double
+   getWork() const
+   {
+      return work;
+   }
+
+   /// sets the work units available for the next call
+   void
+   setWorkBudget( double value )
+   {
+      this->workbudget = value;
+   }
+
+   /// sets the flag that requests the presolver to stop, which may be set
+   /// concurrently by another thread
+   void
+   setInterruptFlag( const std::atomic<bool>* flag )
+   {
+      this->interruptflag = flag;
+   }
+
+   bool
+   isSkipped() const
+   {
+      return skip != 0;
+   }
+
+   void
+   skipRounds( unsigned int nrounds )
+   {
+      this->skip += nrounds;
+   }
+
    void
    setDelayed( bool value )
    {
@@ -261,6 +334,54 @@ class PresolveMethod
       this->enabled = value;
    }
 
+   /// resets the statistics and the skipped rounds of previous calls before
+   /// the presolver is used for another problem
+   void
+   resetCalls()
+   {
+      ncalls = 0;
+      nsuccessCall = 0;
+      nconsecutiveUnsuccessCall = 0;
+      skip = 0;
+      execTime = 0.0;
+      work = 0.0;
+      callwork = 0.0;
+   }
+
+   /// stores the state that is kept over the rounds in a checkpoint
+   void
+   saveCheckpoint( PresolverCheckpoint& checkpoint ) const
+   {
+      checkpoint.name = name;
+      checkpoint.enabled = enabled;
+      checkpoint.delayed = delayed;
+      checkpoint.ncalls = ncalls;
+      checkpoint.nsuccessCall = nsuccessCall;
+      checkpoint.nconsecutiveUnsuccessCall = nconsecutiveUnsuccessCall;
+      checkpoint.skip = skip;
+      checkpoint.execTime = execTime;
+      checkpoint.work = work;
+      checkpoint.data.clear();
+      getCheckpointData( checkpoint.data );
+   }
+
+   /// restores the state of a checkpoint, must be called after initialize()
+   void
+   restoreCheckpoint( const PresolverCheckpoint& checkpoint )
+   {
+      assert( checkpoint.name == name );
+      enabled = checkpoint.enabled;
+      delayed = checkpoint.delayed;
+      ncalls = checkpoint.ncalls;
+      nsuccessCall = checkpoint.nsuccessCall;
+      nconsecutiveUnsuccessCall = checkpoint.nconsecutiveUnsuccessCall;
+      skip = checkpoint.skip;
+      execTime = checkpoint.execTime;
+      work = checkpoint.work;
+      callwork = 0.0;
+      setCheckpointData( checkpoint.data );
+   }
+
    void
    set_symmetries_enabled( bool value )
    {
@@ -362,6 +483,102 @@ class PresolveMethod
              timer.getTime() >= tlim;
    }
 
+   /// returns true if presolve was interrupted
+   bool
+   is_interrupted() const
+   {
+      return interruptflag != nullptr &&
+             interruptflag->load( std::memory_order_relaxed );
+   }
+
+   /// returns true if the time limit or the time budget of the current call
+   /// is exceeded or presolve was interrupted; presolvers polling this can
+   /// stop early and return the reductions found so far
+   bool
+   is_budget_exceeded( const Timer& timer, double tlim ) const
+   {
+      return is_interrupted() ||
+             is_time_exceeded( timer, std::min( tlim, calldeadline ) );
+   }
+
+   /// adds deterministic work units to the current call, must not be called
+   /// concurrently
+   void
+   addWork( double units )
+   {
+      callwork += units;
+   }
+
+   /// returns true if the work of the current call exceeds the work units
+   /// that are left for presolving
+   bool
+   is_work_exceeded() const
+   {
+      return workbudget != std::numeric_limits<double>::max() &&
+             callwork >= workbudget;
+   }
+
+   /// calls itemFunc( k ) for k = 0,...,nitems-1, which returns the work
+   /// units spent on item k. If a work budget is set, the items are processed
+   /// in chunks of fixed size and the remaining items are skipped once the
+   /// budget is exceeded, so the processed items do not depend on the number
+   /// of threads. The items of a chunk are processed in parallel if parallel
+   /// is true. The remaining chunks are also skipped if presolve was
+   /// interrupted. Returns the number of processed items.
+   template <typename ItemFunc>
+   int
+   for_each_within_work_budget( int nitems, bool parallel,
+                                ItemFunc&& itemFunc )
+   {
+      int chunksize = WORK_CHECK_CHUNK_SIZE;
+      if( workbudget == std::numeric_limits<double>::max() )
+         chunksize = std::max( nitems, 1 );
+
+      int first = 0;
+      while( first < nitems && !is_work_exceeded() && !is_interrupted() )
+      {
+         const int last =
+             nitems - first > chunksize ? first + chunksize : nitems;
+         int64_t chunkwork = 0;
+#ifdef PAPILO_TBB
+         if( parallel )
+         {
+            tbb::combinable<int64_t> localwork( []() { return int64_t{ 0 }; } );
+            tbb::parallel_for( tbb::blocked_range<int>( first, last ),
+                               [&]( const tbb::blocked_range<int>& r ) {
+                                  int64_t& w = localwork.local();
+                                  for( int k = r.begin(); k != r.end(); ++k )
+                                     w += itemFunc( k );
+                               } );
+            chunkwork = localwork.combine( std::plus<int64_t>() );
+         }
+         else
+#endif
+         {
+            for( int k = first; k != last; ++k )
+               chunkwork += itemFunc( k );
+         }
+         addWork( static_cast<double>( chunkwork ) );
+         first = last;
+      }
+
+      return first;
+   }
+
+   /// registers the parameter <name>.timebudget, only for presolvers that
+   /// poll is_budget_exceeded()
+   void
+   addTimeBudgetParameter( ParameterSet& paramSet )
+   {
+      paramSet.addParameter(
+          fmt::format( "{}.timebudget", this->name ).c_str(),
+          fmt::format( "time budget in seconds for a single call of "
+                       "presolver {}",
+                       this->name )
+              .c_str(),
+          this->timebudget, 0.0 );
+   }
+
    bool
    check_if_substitution_generates_huge_or_small_coefficients( const Num<REAL>& num,
                                        const ConstraintMatrix<REAL>& constMatrix,
@@ -416,12 +633,6 @@ class PresolveMethod
       return true;
    }
 
-   void
-   skipRounds( unsigned int nrounds )
-   {
-      this->skip += nrounds;
-   }
-
    template <typename LOOP>
    void
    loop( int start, int end, LOOP&& loop_instruction )
@@ -454,6 +665,17 @@ class PresolveMethod
    unsigned int nsuccessCall;
    unsigned int nconsecutiveUnsuccessCall;
    unsigned int skip;
+   double timebudget;
+   double calldeadline;
+   /// number of items between two checks of the work budget in
+   /// for_each_within_work_budget()
+   static constexpr int WORK_CHECK_CHUNK_SIZE = 256;
+
+   double work;
+   double callwork;
+   double workbudget;
+   /// flag of Presolve that requests to stop, may be null
+   const std::atomic<bool>* interruptflag;
    };
 
 } // namespace papilo
@@ -31,20 +31,30 @@ namespace papilo
 
 struct PresolveOptions
 {
+   bool adaptive_selection = false;
+
    bool apply_results_immediately_if_run_sequentially = true;
 
    bool boundrelax = false;
 
    bool calculate_basis_for_dual = true;
 
+   bool component_presolve = false;
+
+   bool concurrent_rounds = false;
+
    bool constraint_propagation_parallel = true;
 
    bool coefficient_strengthening_parallel = true;
 
+   bool detect_blocks = false;
+
    bool dual_fix_parallel = false;
 
    bool implied_integer_parallel = false;
 
+   bool parallel_apply = true;
+
    bool removeslackvars = true;
 
    bool simple_probing_parallel = false;
@@ -57,6 +67,10 @@ struct PresolveOptions
 
    bool validation_after_every_postsolving_step = false;
 
+   bool warmstart = false;
+
+
+   int componentminnnz = 10000;
 
    int componentsmaxint = 0;
 
@@ -81,8 +95,12 @@ struct PresolveOptions
 
    double abortfac = 8e-4;
 
+   double adaptivefac = 0.05;
+
    double bound_tightening_offset = 0.0001;
 
+   double checkpointinterval = 600.0;
+
    double compressfac = 0.85;
 
    double epsilon = 1e-9;
@@ -95,10 +113,14 @@ struct PresolveOptions
 
    double markowitz_tolerance = 0.01;
 
+   double maxlinkingfrac = 0.05;
+
    double minabscoeff = 1e-10;
 
    double tlim = std::numeric_limits<double>::max();
 
+   double worklim = std::numeric_limits<double>::max();
+
 
    bool verification_with_VeriPB = false;
 
@@ -154,6 +176,16 @@ struct PresolveOptions
                              compressfac, 0.0, 1.0 );
       paramSet.addParameter( "presolve.tlim", "time limit for presolve", tlim,
                              0.0 );
+      paramSet.addParameter(
+          "presolve.checkpointinterval",
+          "minimum time in seconds between two checkpoints if a checkpoint "
+          "handler is set",
+          checkpointinterval, 0.0 );
+      paramSet.addParameter(
+          "presolve.worklim",
+          "deterministic work limit for presolve in work units, which roughly "
+          "count visited nonzeros and do not depend on the machine",
+          worklim, 0.0 );
       paramSet.addParameter( "presolve.minabscoeff",
                              "minimum absolute coefficient value allowed in "
                              "matrix, before it is set to zero",
@@ -184,6 +216,52 @@ struct PresolveOptions
           "# if only one thread (presolve.threads = 1) is used, apply the "
           "reductions immediately afterwards",
           apply_results_immediately_if_run_sequentially );
+      paramSet.addParameter(
+          "presolve.concurrentrounds",
+          "run the presolvers of lower timing classes concurrently with the "
+          "presolvers of the current round if the problem changed since their "
+          "last call",
+          concurrent_rounds );
+      paramSet.addParameter(
+          "presolve.componentpresolve",
+          "presolve the disconnected components of the problem independently "
+          "and in parallel (only for primal postsolve)",
+          component_presolve );
+      paramSet.addParameter(
+          "presolve.componentminnnz",
+          "minimum number of nonzeros of the parts that are presolved "
+          "independently, smaller components are grouped together",
+          componentminnnz, 1 );
+      paramSet.addParameter(
+          "presolve.warmstart",
+          "keep the presolved parts of component presolve such that "
+          "Presolve::reapply() only presolves the parts changed by a delta",
+          warmstart );
+      paramSet.addParameter(
+          "presolve.detectblocks",
+          "detect a bordered block diagonal structure and run parallelrows and "
+          "parallelcols on the blocks in parallel",
+          detect_blocks );
+      paramSet.addParameter(
+          "presolve.maxlinkingfrac",
+          "maximal fraction of rows and columns that are linking in the "
+          "detected block structure",
+          maxlinkingfrac, 0.0, 1.0 );
+      paramSet.addParameter(
+          "presolve.parallelapply",
+          "update the row activities of consecutive transactions that only "
+          "change bounds in parallel (the result does not change)",
+          parallel_apply );
+      paramSet.addParameter(
+          "presolve.adaptiveselection",
+          "skip non-fast presolvers whose predicted reductions per second are "
+          "too low compared to the whole presolve",
+          adaptive_selection );
+      paramSet.addParameter(
+          "presolve.adaptivefac",
+          "with adaptive selection a presolver is skipped if its predicted "
+          "reductions per second are below this fraction of the overall rate",
+          adaptivefac, 0.0, 1.0 );
       paramSet.addParameter(
           "propagation.parallel",
           "#execute loop over rows in constraintpropagation in parallel",
@@ -26,7 +26,7 @@
 namespace papilo
 {
 
-#include "papilo/core/MatrixBuffer.hpp"
+#include "papilo/core/BatchMatrixBuffer.hpp"
 #include "papilo/core/Problem.hpp"
 #include "papilo/misc/String.hpp"
 #include "papilo/misc/Vec.hpp"
@@ -202,6 +202,13 @@ class ProblemBuilder
          domains.flags[col].unset( ColFlag::kImplInt );
    }
 
+   /// set all flags of a column at once
+   void
+   setColFlags( int col, ColFlags flags )
+   {
+      domains.flags[col] = flags;
+   }
+
    void
    setColIntegralAll( Vec<uint8_t> isIntegral )
    {
@@ -244,6 +251,13 @@ class ProblemBuilder
          setRowRhsInf( r, isInfinite[r] );
    }
 
+   /// set all flags of a row at once
+   void
+   setRowFlags( int row, RowFlags flags )
+   {
+      rflags[row] = flags;
+   }
+
    void
    setRowLhs( int row, REAL lhsval )
    {
@@ -361,6 +375,7 @@ class ProblemBuilder
 
       problem.setName( std::move( probname ) );
 
+      matrix_buffer.sort();
       problem.setConstraintMatrix( ConstraintMatrix<REAL>{
           matrix_buffer.buildCSR( nRows, nColumns ),
           matrix_buffer.buildCSC( nRows, nColumns ), std::move( lhs ),
@@ -387,7 +402,7 @@ class ProblemBuilder
    }
 
  private:
-   MatrixBuffer<REAL> matrix_buffer;
+   BatchMatrixBuffer<REAL> matrix_buffer;
    Objective<REAL> obj;
    VariableDomains<REAL> domains;
    Vec<REAL> lhs;
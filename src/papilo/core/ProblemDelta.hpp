@@ -0,0 +1,216 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_PROBLEM_DELTA_HPP_
+#define _PAPILO_CORE_PROBLEM_DELTA_HPP_
+
+#include "papilo/core/Problem.hpp"
+#include "papilo/misc/Num.hpp"
+#include "papilo/misc/Vec.hpp"
+#include <cassert>
+
+namespace papilo
+{
+
+enum class DeltaType : int
+{
+   kColLb,
+   kColUb,
+   kObj,
+   kRowLhs,
+   kRowRhs,
+};
+
+/// modification of a bound, objective coefficient or side of a problem
+template <typename REAL>
+struct DeltaEntry
+{
+   DeltaType type;
+   int index;
+   REAL value;
+   bool infinite;
+};
+
+/// records changes of the bounds, objective coefficients and sides of a
+/// problem, e.g., between two solves of the same model. The changes are
+/// applied in the order they were recorded. Changes of the matrix are not
+/// supported since they may change the structure of the problem.
+template <typename REAL>
+class ProblemDelta
+{
+ public:
+   void
+   changeColLb( int col, REAL value )
+   {
+      entries.push_back( { DeltaType::kColLb, col, std::move( value ), false } );
+   }
+
+   void
+   changeColLbInf( int col )
+   {
+      entries.push_back( { DeltaType::kColLb, col, REAL{ 0 }, true } );
+   }
+
+   void
+   changeColUb( int col, REAL value )
+   {
+      entries.push_back( { DeltaType::kColUb, col, std::move( value ), false } );
+   }
+
+   void
+   changeColUbInf( int col )
+   {
+      entries.push_back( { DeltaType::kColUb, col, REAL{ 0 }, true } );
+   }
+
+   void
+   changeObj( int col, REAL value )
+   {
+      entries.push_back( { DeltaType::kObj, col, std::move( value ), false } );
+   }
+
+   void
+   changeRowLhs( int row, REAL value )
+   {
+      entries.push_back(
+          { DeltaType::kRowLhs, row, std::move( value ), false } );
+   }
+
+   void
+   changeRowLhsInf( int row )
+   {
+      entries.push_back( { DeltaType::kRowLhs, row, REAL{ 0 }, true } );
+   }
+
+   void
+   changeRowRhs( int row, REAL value )
+   {
+      entries.push_back(
+          { DeltaType::kRowRhs, row, std::move( value ), false } );
+   }
+
+   void
+   changeRowRhsInf( int row )
+   {
+      entries.push_back( { DeltaType::kRowRhs, row, REAL{ 0 }, true } );
+   }
+
+   bool
+   empty() const
+   {
+      return entries.empty();
+   }
+
+   void
+   clear()
+   {
+      entries.clear();
+   }
+
+   const Vec<DeltaEntry<REAL>>&
+   getEntries() const
+   {
+      return entries;
+   }
+
+   /// applies the changes to the problem, sides that become equal turn the
+   /// row into an equation
+   void
+   apply( Problem<REAL>& problem, const Num<REAL>& num ) const;
+
+   /// sets the flags of the rows and columns that are modified by the delta
+   void
+   markModified( Vec<uint8_t>& modifiedrows, Vec<uint8_t>& modifiedcols ) const
+   {
+      for( const DeltaEntry<REAL>& entry : entries )
+      {
+         if( entry.type == DeltaType::kRowLhs ||
+             entry.type == DeltaType::kRowRhs )
+            modifiedrows[entry.index] = true;
+         else
+            modifiedcols[entry.index] = true;
+      }
+   }
+
+ private:
+   Vec<DeltaEntry<REAL>> entries;
+};
+
+template <typename REAL>
+void
+ProblemDelta<REAL>::apply( Problem<REAL>& problem, const Num<REAL>& num ) const
+{
+   ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+   Vec<ColFlags>& cflags = problem.getColFlags();
+   Vec<REAL>& lbs = problem.getLowerBounds();
+   Vec<REAL>& ubs = problem.getUpperBounds();
+   Vec<REAL>& obj = problem.getObjective().coefficients;
+
+   for( const DeltaEntry<REAL>& entry : entries )
+   {
+      switch( entry.type )
+      {
+      case DeltaType::kColLb:
+         assert( entry.index >= 0 && entry.index < problem.getNCols() );
+         if( entry.infinite )
+            cflags[entry.index].set( ColFlag::kLbInf );
+         else
+         {
+            cflags[entry.index].unset( ColFlag::kLbInf );
+            lbs[entry.index] = entry.value;
+         }
+         break;
+      case DeltaType::kColUb:
+         assert( entry.index >= 0 && entry.index < problem.getNCols() );
+         if( entry.infinite )
+            cflags[entry.index].set( ColFlag::kUbInf );
+         else
+         {
+            cflags[entry.index].unset( ColFlag::kUbInf );
+            ubs[entry.index] = entry.value;
+         }
+         break;
+      case DeltaType::kObj:
+         assert( entry.index >= 0 && entry.index < problem.getNCols() );
+         obj[entry.index] = entry.value;
+         break;
+      case DeltaType::kRowLhs:
+         assert( entry.index >= 0 && entry.index < problem.getNRows() );
+         if( entry.infinite )
+            consMatrix.template modifyLeftHandSide<true>( entry.index, num );
+         else
+            consMatrix.modifyLeftHandSide( entry.index, num, entry.value );
+         break;
+      case DeltaType::kRowRhs:
+         assert( entry.index >= 0 && entry.index < problem.getNRows() );
+         if( entry.infinite )
+            consMatrix.template modifyRightHandSide<true>( entry.index, num );
+         else
+            consMatrix.modifyRightHandSide( entry.index, num, entry.value );
+         break;
+      }
+   }
+}
+
+} // namespace papilo
+
+#endif
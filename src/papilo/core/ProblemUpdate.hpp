@@ -24,7 +24,9 @@
 #define _PAPILO_CORE_PROBLEM_UPDATE_HPP_
 
 #include "boost/random.hpp"
-#include "papilo/core/MatrixBuffer.hpp"
+#include "papilo/core/BatchMatrixBuffer.hpp"
+#include "papilo/core/BlockStructure.hpp"
+#include "papilo/core/CheckpointState.hpp"
 #include "papilo/core/PresolveMethod.hpp"
 #include "papilo/core/PresolveOptions.hpp"
 #include "papilo/core/Problem.hpp"
@@ -82,11 +84,32 @@ class ProblemUpdate
    Vec<int> emptyColumns;
    int firstNewSingletonCol;
 
-   MatrixBuffer<REAL> matrix_buffer;
+   BatchMatrixBuffer<REAL> matrix_buffer;
    Vec<int> intbuffer;
    Vec<REAL> realbuffer;
    Vec<Triplet<REAL>> tripletbuffer;
 
+   /// bound change whose update of the row activities has been deferred
+   struct DeferredBoundChange
+   {
+      int col;
+      BoundChange type;
+      bool oldbound_useless;
+      REAL oldbound;
+      REAL newbound;
+   };
+
+   /// minimum number of deferred coefficient updates to process them in
+   /// parallel
+   static constexpr int MIN_PARALLEL_ACTIVITY_UPDATES = 1 << 12;
+
+   bool deferActivityUpdates = false;
+   bool deferring = false;
+   Vec<DeferredBoundChange> deferredBoundChanges;
+   /// position of a row among the rows touched by the deferred updates, -1
+   /// for the other rows
+   Vec<int> deferredRowIndex;
+
    Vec<PresolveMethod<REAL>*> compress_observers;
 
    Vec<int> random_col_perm;
@@ -104,6 +127,15 @@ class ProblemUpdate
 
    Vec<Flags<State>> row_state;
    Vec<Flags<State>> col_state;
+
+   /// round in which the coefficients or the support of a row/column were
+   /// modified last, unlike the states these are kept over the rounds
+   Vec<int> row_modified_round;
+   Vec<int> col_modified_round;
+   /// bordered block diagonal structure if it was detected
+   BlockStructure block_structure;
+   /// the block structure was detected and is kept up to date
+   bool block_structure_requested = false;
    std::unique_ptr<CertificateInterface<REAL>> certificate_interface;
 
  public:
@@ -125,6 +157,9 @@ class ProblemUpdate
          dirty_col_states.push_back( col );
 
       col_state[col].set( flags... );
+
+      if( col_state[col].test( State::kModified ) )
+         col_modified_round[col] = stats.nrounds;
    }
 
    template <typename... Args>
@@ -151,6 +186,9 @@ class ProblemUpdate
          dirty_row_states.push_back( row );
 
       row_state[row].set( flags... );
+
+      if( row_state[row].test( State::kModified ) )
+         row_modified_round[row] = stats.nrounds;
    }
 
  public:
@@ -169,11 +207,39 @@ class ProblemUpdate
       this->postponeSubstitutions = value;
    }
 
+   /// while enabled, the row activity updates of transactions that only
+   /// change bounds are collected and applied in parallel when a different
+   /// transaction is applied or the deferral is disabled again
+   void
+   setDeferActivityUpdates( bool value )
+   {
+      deferring = false;
+      flushActivityUpdates();
+      this->deferActivityUpdates = value;
+   }
+
+   /// applies the deferred row activity updates; the rows are processed in
+   /// parallel while the updates of each row and the order of the changed
+   /// activities stay the same as if applied directly
+   void
+   flushActivityUpdates();
 
    void
    update_activity( ActivityChange actChange, int rowid,
                     RowActivity<REAL>& activity );
 
+   bool
+   mark_activity_changed( ActivityChange actChange, int rowid,
+                          RowActivity<REAL>& activity );
+
+   void
+   update_activities_of_col( int col, BoundChange type, const REAL& oldbound,
+                             const REAL& newbound, bool oldbound_useless );
+
+   static bool
+   is_bound_change_transaction( const Reduction<REAL>* first,
+                                const Reduction<REAL>* last );
+
    PresolveStatus
    fixCol( int col, REAL val, ArgumentType argument = ArgumentType::kPrimal );
 
@@ -314,6 +380,11 @@ class ProblemUpdate
    void
    clearStates();
 
+   /// marks the rows of the deleted columns and the columns of the redundant
+   /// rows as modified before they are removed from the matrix
+   void
+   markSupportOfDeletedModified();
+
    void
    check_and_compress();
 
@@ -335,6 +406,84 @@ class ProblemUpdate
         deleted_cols.push_back(col);
     }
 
+   int
+   getRound() const
+   {
+      return stats.nrounds;
+   }
+
+   /// round in which the coefficients or the support of each row changed last
+   const Vec<int>&
+   getRowModifiedRounds() const
+   {
+      return row_modified_round;
+   }
+
+   /// round in which the coefficients or the support of each column changed
+   /// last
+   const Vec<int>&
+   getColModifiedRounds() const
+   {
+      return col_modified_round;
+   }
+
+   const BlockStructure&
+   getBlockStructure() const
+   {
+      return block_structure;
+   }
+
+   /// detects a bordered block diagonal structure of the active problem,
+   /// returns the number of blocks
+   int
+   detectBlockStructure()
+   {
+      block_structure_requested = true;
+      return block_structure.detectBlocks( problem,
+                                           presolveOptions.maxlinkingfrac );
+   }
+
+   /// stores the state that is kept over the rounds, the states of the rows
+   /// and columns must be cleared
+   void
+   saveCheckpoint( ProblemUpdateCheckpoint& checkpoint ) const
+   {
+      assert( dirty_row_states.empty() && dirty_col_states.empty() );
+      checkpoint.singletonRows = singletonRows;
+      checkpoint.singletonColumns = singletonColumns;
+      checkpoint.emptyColumns = emptyColumns;
+      checkpoint.firstNewSingletonCol = firstNewSingletonCol;
+      checkpoint.changed_activities = changed_activities;
+      checkpoint.deleted_cols = deleted_cols;
+      checkpoint.redundant_rows = redundant_rows;
+      checkpoint.random_col_perm = random_col_perm;
+      checkpoint.random_row_perm = random_row_perm;
+      checkpoint.row_modified_round = row_modified_round;
+      checkpoint.col_modified_round = col_modified_round;
+      checkpoint.lastcompress_ndelcols = lastcompress_ndelcols;
+      checkpoint.lastcompress_ndelrows = lastcompress_ndelrows;
+   }
+
+   void
+   restoreCheckpoint( ProblemUpdateCheckpoint checkpoint )
+   {
+      assert( checkpoint.random_col_perm.size() == col_state.size() );
+      assert( checkpoint.random_row_perm.size() == row_state.size() );
+      singletonRows = std::move( checkpoint.singletonRows );
+      singletonColumns = std::move( checkpoint.singletonColumns );
+      emptyColumns = std::move( checkpoint.emptyColumns );
+      firstNewSingletonCol = checkpoint.firstNewSingletonCol;
+      changed_activities = std::move( checkpoint.changed_activities );
+      deleted_cols = std::move( checkpoint.deleted_cols );
+      redundant_rows = std::move( checkpoint.redundant_rows );
+      random_col_perm = std::move( checkpoint.random_col_perm );
+      random_row_perm = std::move( checkpoint.random_row_perm );
+      row_modified_round = std::move( checkpoint.row_modified_round );
+      col_modified_round = std::move( checkpoint.col_modified_round );
+      lastcompress_ndelcols = checkpoint.lastcompress_ndelcols;
+      lastcompress_ndelrows = checkpoint.lastcompress_ndelrows;
+   }
+
    const Vec<int>&
    getRandomColPerm() const
    {
@@ -457,6 +606,8 @@ ProblemUpdate<REAL>::ProblemUpdate(
 {
    row_state.resize( _problem.getNRows() );
    col_state.resize( _problem.getNCols() );
+   row_modified_round.resize( _problem.getNRows(), 0 );
+   col_modified_round.resize( _problem.getNCols(), 0 );
    postponeSubstitutions = true;
    firstNewSingletonCol = 0;
    certificate_interface =
@@ -490,6 +641,8 @@ ProblemUpdate<REAL>::ProblemUpdate(
 {
    row_state.resize( _problem.getNRows() );
    col_state.resize( _problem.getNCols() );
+   row_modified_round.resize( _problem.getNRows(), 0 );
+   col_modified_round.resize( _problem.getNCols(), 0 );
    postponeSubstitutions = true;
    firstNewSingletonCol = 0;
    certificate_interface = std::move(_certificate_interface);
@@ -540,23 +693,220 @@ template <typename REAL>
 void
 ProblemUpdate<REAL>::update_activity( ActivityChange actChange, int rowid,
                                       RowActivity<REAL>& activity )
+{
+   if( mark_activity_changed( actChange, rowid, activity ) )
+      changed_activities.push_back( rowid );
+}
+
+template <typename REAL>
+bool
+ProblemUpdate<REAL>::mark_activity_changed( ActivityChange actChange,
+                                            int rowid,
+                                            RowActivity<REAL>& activity )
 {
    if( activity.lastchange == stats.nrounds ||
        ( actChange == ActivityChange::kMin && activity.ninfmin > 1 ) ||
        ( actChange == ActivityChange::kMax && activity.ninfmax > 1 ) ||
        problem.getConstraintMatrix().isRowRedundant( rowid ) )
-      return;
+      return false;
 
    activity.lastchange = stats.nrounds;
 
-   changed_activities.push_back( rowid );
+   return true;
+}
+
+template <typename REAL>
+void
+ProblemUpdate<REAL>::update_activities_of_col( int col, BoundChange type,
+                                               const REAL& oldbound,
+                                               const REAL& newbound,
+                                               bool oldbound_useless )
+{
+   if( deferring )
+   {
+      deferredBoundChanges.push_back(
+          { col, type, oldbound_useless, oldbound, newbound } );
+      return;
+   }
+
+   auto colvec = problem.getConstraintMatrix().getColumnCoefficients( col );
+   update_activities_after_boundchange(
+       colvec.getValues(), colvec.getIndices(), colvec.getLength(), type,
+       oldbound, newbound, oldbound_useless, problem.getRowActivities(),
+       [this]( ActivityChange actChange, int rowid,
+               RowActivity<REAL>& activity ) {
+          update_activity( actChange, rowid, activity );
+       } );
+}
+
+template <typename REAL>
+void
+ProblemUpdate<REAL>::flushActivityUpdates()
+{
+   const int nupdates = static_cast<int>( deferredBoundChanges.size() );
+   if( nupdates == 0 )
+      return;
+
+   const ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+   Vec<RowActivity<REAL>>& activities = problem.getRowActivities();
+
+   // position of the coefficients of each update among the coefficients of
+   // all updates, each coefficient reports at most one changed activity
+   Vec<int> eventstart( nupdates + 1 );
+   eventstart[0] = 0;
+   for( int i = 0; i != nupdates; ++i )
+      eventstart[i + 1] =
+          eventstart[i] +
+          consMatrix.getColSizes()[deferredBoundChanges[i].col];
+
+#ifdef PAPILO_TBB
+   if( nupdates > 1 && eventstart[nupdates] >= MIN_PARALLEL_ACTIVITY_UPDATES )
+   {
+      // group the coefficients of the updates by row, such that each row is
+      // updated by one task in the original order of the updates; a dense
+      // row shared by many updates is one sequential task instead of
+      // serializing the updates
+      const int nentries = eventstart[nupdates];
+      deferredRowIndex.resize( consMatrix.getNRows(), -1 );
+      Vec<int> touchedrows;
+      Vec<int> rowstart( 1, 0 );
+
+      for( int i = 0; i != nupdates; ++i )
+      {
+         auto colvec =
+             consMatrix.getColumnCoefficients( deferredBoundChanges[i].col );
+         const int* rows = colvec.getIndices();
+         for( int j = 0; j != colvec.getLength(); ++j )
+         {
+            if( deferredRowIndex[rows[j]] == -1 )
+            {
+               deferredRowIndex[rows[j]] =
+                   static_cast<int>( touchedrows.size() );
+               touchedrows.push_back( rows[j] );
+               rowstart.push_back( 0 );
+            }
+            ++rowstart[deferredRowIndex[rows[j]] + 1];
+         }
+      }
+
+      const int ntouched = static_cast<int>( touchedrows.size() );
+      for( int t = 0; t != ntouched; ++t )
+         rowstart[t + 1] += rowstart[t];
+
+      // the coefficients of each row in the order of the updates, given by
+      // their position among the coefficients of all updates
+      Vec<int> rowentries( nentries );
+      Vec<int> entryupdate( nentries );
+      Vec<int> fill( rowstart.begin(), rowstart.end() - 1 );
+      for( int i = 0; i != nupdates; ++i )
+      {
+         auto colvec =
+             consMatrix.getColumnCoefficients( deferredBoundChanges[i].col );
+         const int* rows = colvec.getIndices();
+         for( int j = 0; j != colvec.getLength(); ++j )
+         {
+            rowentries[fill[deferredRowIndex[rows[j]]]++] = eventstart[i] + j;
+            entryupdate[eventstart[i] + j] = i;
+         }
+      }
+
+      for( int row : touchedrows )
+         deferredRowIndex[row] = -1;
+
+      Vec<uint8_t> changed( nentries, false );
+
+      tbb::parallel_for(
+          tbb::blocked_range<int>( 0, ntouched ),
+          [&]( const tbb::blocked_range<int>& r ) {
+             for( int t = r.begin(); t != r.end(); ++t )
+             {
+                for( int k = rowstart[t]; k != rowstart[t + 1]; ++k )
+                {
+                   const int e = rowentries[k];
+                   const int i = entryupdate[e];
+                   const int j = e - eventstart[i];
+                   const DeferredBoundChange& chg = deferredBoundChanges[i];
+                   auto colvec = consMatrix.getColumnCoefficients( chg.col );
+                   update_activities_after_boundchange(
+                       colvec.getValues() + j, colvec.getIndices() + j, 1,
+                       chg.type, chg.oldbound, chg.newbound,
+                       chg.oldbound_useless, activities,
+                       [&]( ActivityChange actChange, int rowid,
+                            RowActivity<REAL>& activity ) {
+                          if( mark_activity_changed( actChange, rowid,
+                                                     activity ) )
+                             changed[e] = true;
+                       } );
+                }
+             }
+          } );
+
+      // report the changed activities in the order of the updates
+      for( int i = 0; i != nupdates; ++i )
+      {
+         auto colvec =
+             consMatrix.getColumnCoefficients( deferredBoundChanges[i].col );
+         for( int j = 0; j != colvec.getLength(); ++j )
+         {
+            if( changed[eventstart[i] + j] )
+               changed_activities.push_back( colvec.getIndices()[j] );
+         }
+      }
+
+      deferredBoundChanges.clear();
+      return;
+   }
+#endif
+
+   for( int i = 0; i != nupdates; ++i )
+   {
+      const DeferredBoundChange& chg = deferredBoundChanges[i];
+      auto colvec = consMatrix.getColumnCoefficients( chg.col );
+      update_activities_after_boundchange(
+          colvec.getValues(), colvec.getIndices(), colvec.getLength(),
+          chg.type, chg.oldbound, chg.newbound, chg.oldbound_useless,
+          activities,
+          [this]( ActivityChange actChange, int rowid,
+                  RowActivity<REAL>& activity ) {
+             update_activity( actChange, rowid, activity );
+          } );
+   }
+
+   deferredBoundChanges.clear();
+}
+
+template <typename REAL>
+bool
+ProblemUpdate<REAL>::is_bound_change_transaction(
+    const Reduction<REAL>* first, const Reduction<REAL>* last )
+{
+   for( auto iter = first; iter < last; ++iter )
+   {
+      if( iter->row < 0 )
+      {
+         switch( iter->row )
+         {
+         case ColReduction::LOCKED:
+         case ColReduction::BOUNDS_LOCKED:
+         case ColReduction::LOWER_BOUND:
+         case ColReduction::UPPER_BOUND:
+         case ColReduction::FIXED:
+            break;
+         default:
+            return false;
+         }
+      }
+      else if( iter->col != RowReduction::LOCKED )
+         return false;
+   }
+
+   return true;
 }
 
 template <typename REAL>
 PresolveStatus
 ProblemUpdate<REAL>::fixCol( int col, REAL val, ArgumentType argument )
 {
-   ConstraintMatrix<REAL>& constraintMatrix = problem.getConstraintMatrix();
    Vec<REAL>& lbs = problem.getLowerBounds();
    Vec<REAL>& ubs = problem.getUpperBounds();
    Vec<ColFlags>& cflags = problem.getColFlags();
@@ -564,11 +914,6 @@ ProblemUpdate<REAL>::fixCol( int col, REAL val, ArgumentType argument )
    if( cflags[col].test( ColFlag::kSubstituted ) )
       return PresolveStatus::kUnchanged;
 
-   auto updateActivity = [this]( ActivityChange actChange, int rowid,
-                                 RowActivity<REAL>& activity ) {
-      update_activity( actChange, rowid, activity );
-   };
-
    bool lbchanged = cflags[col].test( ColFlag::kLbInf ) || val != lbs[col];
    bool ubchanged = cflags[col].test( ColFlag::kUbInf ) || val != ubs[col];
 
@@ -579,8 +924,6 @@ ProblemUpdate<REAL>::fixCol( int col, REAL val, ArgumentType argument )
 
    if( lbchanged || ubchanged )
    {
-      auto colvec = constraintMatrix.getColumnCoefficients( col );
-
       if( ( !cflags[col].test( ColFlag::kLbInf ) &&
             num.isFeasLT( val, lbs[col] ) ) ||
           ( !cflags[col].test( ColFlag::kUbInf ) &&
@@ -609,11 +952,8 @@ ProblemUpdate<REAL>::fixCol( int col, REAL val, ArgumentType argument )
 
       if( lbchanged )
       {
-         update_activities_after_boundchange(
-             colvec.getValues(), colvec.getIndices(), colvec.getLength(),
-             BoundChange::kLower, lbs[col], val,
-             cflags[col].test( ColFlag::kLbUseless ),
-             problem.getRowActivities(), updateActivity );
+         update_activities_of_col( col, BoundChange::kLower, lbs[col], val,
+                                   cflags[col].test( ColFlag::kLbUseless ) );
 
          postsolve.storeVarBoundChange(
              true, col, lbs[col],
@@ -627,11 +967,8 @@ ProblemUpdate<REAL>::fixCol( int col, REAL val, ArgumentType argument )
 
       if( ubchanged )
       {
-         update_activities_after_boundchange(
-             colvec.getValues(), colvec.getIndices(), colvec.getLength(),
-             BoundChange::kUpper, ubs[col], val,
-             cflags[col].test( ColFlag::kUbUseless ),
-             problem.getRowActivities(), updateActivity );
+         update_activities_of_col( col, BoundChange::kUpper, ubs[col], val,
+                                   cflags[col].test( ColFlag::kUbUseless ) );
 
          postsolve.storeVarBoundChange(
              false, col, ubs[col],
@@ -695,7 +1032,6 @@ template <typename REAL>
 PresolveStatus
 ProblemUpdate<REAL>::changeLB( int col, REAL val, ArgumentType argument )
 {
-   ConstraintMatrix<REAL>& constraintMatrix = problem.getConstraintMatrix();
    Vec<ColFlags>& cflags = problem.getColFlags();
    Vec<REAL>& lbs = problem.getLowerBounds();
    Vec<REAL>& ubs = problem.getUpperBounds();
@@ -705,11 +1041,6 @@ ProblemUpdate<REAL>::changeLB( int col, REAL val, ArgumentType argument )
 
    REAL newbound = val;
 
-   auto updateActivity = [this]( ActivityChange actChange, int rowid,
-                                 RowActivity<REAL>& activity ) {
-      update_activity( actChange, rowid, activity );
-   };
-
    if( cflags[col].test( ColFlag::kIntegral, ColFlag::kImplInt ) )
       newbound = num.feasCeil( newbound );
 
@@ -747,12 +1078,8 @@ ProblemUpdate<REAL>::changeLB( int col, REAL val, ArgumentType argument )
 
       if( !num.isHugeVal( newbound ) )
       {
-         auto colvec = constraintMatrix.getColumnCoefficients( col );
-         update_activities_after_boundchange(
-             colvec.getValues(), colvec.getIndices(), colvec.getLength(),
-             BoundChange::kLower, lbs[col], newbound,
-             cflags[col].test( ColFlag::kLbUseless ),
-             problem.getRowActivities(), updateActivity );
+         update_activities_of_col( col, BoundChange::kLower, lbs[col], newbound,
+                                   cflags[col].test( ColFlag::kLbUseless ) );
 
          cflags[col].unset( ColFlag::kLbUseless );
       }
@@ -791,7 +1118,6 @@ template <typename REAL>
 PresolveStatus
 ProblemUpdate<REAL>::changeUB( int col, REAL val, ArgumentType argument )
 {
-   ConstraintMatrix<REAL>& constraintMatrix = problem.getConstraintMatrix();
    Vec<ColFlags>& cflags = problem.getColFlags();
    Vec<REAL>& lbs = problem.getLowerBounds();
    Vec<REAL>& ubs = problem.getUpperBounds();
@@ -801,11 +1127,6 @@ ProblemUpdate<REAL>::changeUB( int col, REAL val, ArgumentType argument )
 
    REAL newbound = val;
 
-   auto updateActivity = [this]( ActivityChange actChange, int rowid,
-                                 RowActivity<REAL>& activity ) {
-      update_activity( actChange, rowid, activity );
-   };
-
    if( cflags[col].test( ColFlag::kIntegral, ColFlag::kImplInt ) )
       newbound = num.feasFloor( newbound );
 
@@ -843,12 +1164,8 @@ ProblemUpdate<REAL>::changeUB( int col, REAL val, ArgumentType argument )
 
       if( !num.isHugeVal( newbound ) )
       {
-         auto colvec = constraintMatrix.getColumnCoefficients( col );
-         update_activities_after_boundchange(
-             colvec.getValues(), colvec.getIndices(), colvec.getLength(),
-             BoundChange::kUpper, ubs[col], newbound,
-             cflags[col].test( ColFlag::kUbUseless ),
-             problem.getRowActivities(), updateActivity );
+         update_activities_of_col( col, BoundChange::kUpper, ubs[col], newbound,
+                                   cflags[col].test( ColFlag::kUbUseless ) );
          cflags[col].unset( ColFlag::kUbUseless );
       }
       else
@@ -924,11 +1241,23 @@ ProblemUpdate<REAL>::compress( bool full )
           if( full )
              changed_activities.shrink_to_fit();
        },
+       [this, &mappings, full]() {
+          compress_vector( mappings.first, row_modified_round );
+          compress_vector( mappings.second, col_modified_round );
+          if( full )
+          {
+             row_modified_round.shrink_to_fit();
+             col_modified_round.shrink_to_fit();
+          }
+       },
        [this, &mappings, full]() {
           compress_index_vector( mappings.first, singletonRows );
           if( full )
              singletonRows.shrink_to_fit();
        },
+       [this, &mappings, full]() {
+          block_structure.compress( mappings.first, mappings.second, full );
+       },
        [this, &mappings, full]() {
           certificate_interface->compress( mappings.first, mappings.second, full );
        },
@@ -959,7 +1288,10 @@ ProblemUpdate<REAL>::compress( bool full )
    postsolve.compress( mappings.first, mappings.second, full );
    certificate_interface->compress( mappings.first, mappings.second, full );
    compress_index_vector( mappings.first, changed_activities );
+   compress_vector( mappings.first, row_modified_round );
+   compress_vector( mappings.second, col_modified_round );
    compress_index_vector( mappings.first, singletonRows );
+   block_structure.compress( mappings.first, mappings.second, full );
    compress_index_vector( mappings.second, emptyColumns );
    int numNewSingletonCols =
        static_cast<int>( singletonColumns.size() ) -
@@ -976,7 +1308,8 @@ ProblemUpdate<REAL>::compress( bool full )
       singletonRows.shrink_to_fit();
       emptyColumns.shrink_to_fit();
       singletonColumns.shrink_to_fit();
-
+      row_modified_round.shrink_to_fit();
+      col_modified_round.shrink_to_fit();
    }
    for( PresolveMethod<REAL>* observer : compress_observers )
       observer->compress( mappings.first, mappings.second );
@@ -1058,6 +1391,8 @@ ProblemUpdate<REAL>::flushChangedCoeffs()
              [this, row]( ActivityChange actChange,
                           RowActivity<REAL>& activity )
              { update_activity( actChange, row, activity ); } );
+         row_modified_round[row] = stats.nrounds;
+         col_modified_round[col] = stats.nrounds;
          ++stats.ncoefchgs;
          // TODO: update up/down-locks -> so that i.e. DualFix can use it
       };
@@ -1119,6 +1454,7 @@ ProblemUpdate<REAL>::flush( bool reset_changed_activities )
 
    // delete fixed columns and redundant rows form the matrix
    // TODO update locks in delete rows and cols function
+   markSupportOfDeletedModified();
    consMatrix.deleteRowsAndCols( redundant_rows, deleted_cols, activities,
                                  singletonRows, singletonColumns,
                                  emptyColumns );
@@ -1194,10 +1530,44 @@ ProblemUpdate<REAL>::clearStates()
        } ) );
 }
 
+template <typename REAL>
+void
+ProblemUpdate<REAL>::markSupportOfDeletedModified()
+{
+   const ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+   const Vec<int>& rowsizes = consMatrix.getRowSizes();
+   const Vec<int>& colsizes = consMatrix.getColSizes();
+
+   for( int row : redundant_rows )
+   {
+      if( rowsizes[row] == -1 )
+         continue;
+
+      row_modified_round[row] = stats.nrounds;
+      auto rowvec = consMatrix.getRowCoefficients( row );
+      const int* rowcols = rowvec.getIndices();
+      for( int i = 0; i != rowvec.getLength(); ++i )
+         col_modified_round[rowcols[i]] = stats.nrounds;
+   }
+
+   for( int col : deleted_cols )
+   {
+      if( colsizes[col] == -1 )
+         continue;
+
+      col_modified_round[col] = stats.nrounds;
+      auto colvec = consMatrix.getColumnCoefficients( col );
+      const int* colrows = colvec.getIndices();
+      for( int i = 0; i != colvec.getLength(); ++i )
+         row_modified_round[colrows[i]] = stats.nrounds;
+   }
+}
+
 template <typename REAL>
 void
 ProblemUpdate<REAL>::check_and_compress()
 {
+   bool compressed = false;
    if( presolveOptions.compressfac != 0 &&
        ( ( problem.getNCols() > 100 &&
            getNActiveCols() <
@@ -1205,7 +1575,19 @@ ProblemUpdate<REAL>::check_and_compress()
          ( problem.getNRows() > 100 &&
            getNActiveRows() <
                problem.getNRows() * presolveOptions.compressfac ) ) )
+   {
       compress();
+      compressed = true;
+   }
+
+   // the block structure of the shrunk problem or after the removal of most
+   // linking rows and columns can have more and smaller blocks
+   if( block_structure_requested &&
+       ( compressed || block_structure.isStale( problem ) ) )
+   {
+      int nblocks = detectBlockStructure();
+      Message::debug( this, "detected {} blocks again\n", nblocks );
+   }
 }
 
 template <typename REAL>
@@ -1616,6 +1998,7 @@ ProblemUpdate<REAL>::trivialPresolve()
 
    removeFixedCols();
 
+   markSupportOfDeletedModified();
    problem.getConstraintMatrix().deleteRowsAndCols(
        redundant_rows, deleted_cols, problem.getRowActivities(), singletonRows,
        singletonColumns, emptyColumns );
@@ -2091,6 +2474,15 @@ ProblemUpdate<REAL>::applyTransaction( const Reduction<REAL>* first,
    else if( conflictType == ConflictType::kPostpone )
       return ApplyResult::kPostponed;
 
+   // other reductions may depend on the activities, so the deferred updates
+   // are applied before them
+   if( deferActivityUpdates )
+   {
+      deferring = is_bound_change_transaction( first, last );
+      if( !deferring )
+         flushActivityUpdates();
+   }
+
    print_detailed( first, last );
 
    certificate_interface->start_transaction();
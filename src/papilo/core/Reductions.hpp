@@ -23,6 +23,7 @@
 #ifndef _PAPILO_CORE_REDUCTIONS_HPP_
 #define _PAPILO_CORE_REDUCTIONS_HPP_
 
+#include "papilo/misc/RoundArena.hpp"
 #include "papilo/misc/Vec.hpp"
 #include <cassert>
 
@@ -99,6 +100,14 @@ template <typename REAL>
 class Reductions
 {
  public:
+   /// if an arena is given the reductions are allocated from it and must be
+   /// released before the arena is reset
+   explicit Reductions( RoundArena* arena = nullptr )
+       : reductions( ArenaAllocator<Reduction<REAL>>( arena ) ),
+         transactions( ArenaAllocator<Transaction>( arena ) )
+   {
+   }
+
    void
    startTransaction()
    {
@@ -376,7 +385,35 @@ class Reductions
       transactions.clear();
    }
 
-   const Vec<Reduction<REAL>>&
+   /// appends the reductions and transactions of other, which must not have
+   /// an open transaction
+   void
+   append( const Reductions<REAL>& other )
+   {
+      assert( transactions.empty() || transactions.back().end >= 0 );
+
+      const int offset = static_cast<int>( reductions.size() );
+      reductions.insert( reductions.end(), other.reductions.begin(),
+                         other.reductions.end() );
+
+      for( const Transaction& tx : other.transactions )
+      {
+         assert( tx.end >= 0 );
+         transactions.push_back( tx );
+         transactions.back().start += offset;
+         transactions.back().end += offset;
+      }
+   }
+
+   /// clears the reductions and gives back their memory
+   void
+   release()
+   {
+      reductions = ArenaVec<Reduction<REAL>>( reductions.get_allocator() );
+      transactions = ArenaVec<Transaction>( transactions.get_allocator() );
+   }
+
+   const ArenaVec<Reduction<REAL>>&
    getReductions() const
    {
       return reductions;
@@ -395,15 +432,15 @@ class Reductions
       }
    };
 
-   const Vec<Transaction>&
+   const ArenaVec<Transaction>&
    getTransactions() const
    {
       return transactions;
    }
 
  private:
-   Vec<Reduction<REAL>> reductions;
-   Vec<Transaction> transactions;
+   ArenaVec<Reduction<REAL>> reductions;
+   ArenaVec<Transaction> transactions;
 
  public:
    Reduction<REAL>&
@@ -29,6 +29,10 @@
 #include "papilo/misc/Num.hpp"
 #include "papilo/misc/Vec.hpp"
 #include <tuple>
+#if defined( __AVX512F__ ) || defined( __AVX2__ )
+#include <bitset>
+#include <immintrin.h>
+#endif
 
 namespace papilo
 {
@@ -168,21 +172,18 @@ count_locks( const REAL& val, RowFlags rflags, int& ndownlocks, int& nuplocks )
    }
 }
 
+/// adds the contributions of the given row entries to the activity. This is
+/// the scalar kernel shared by all number types; the double precision
+/// specialization of compute_row_activity() uses it for the remainder of a
+/// row that does not fill a full vector register
 template <typename REAL>
-RowActivity<REAL>
-compute_row_activity( const REAL* rowvals, const int* colindices, int rowlen,
-                      const Vec<REAL>& lower_bounds,
-                      const Vec<REAL>& upper_bounds, const Vec<ColFlags>& flags,
-                      int presolveround = -1 )
+void
+accumulate_row_activity( RowActivity<REAL>& activity, const REAL* rowvals,
+                         const int* colindices, int rowlen,
+                         const Vec<REAL>& lower_bounds,
+                         const Vec<REAL>& upper_bounds,
+                         const Vec<ColFlags>& flags )
 {
-   RowActivity<REAL> activity;
-
-   activity.min = 0.0;
-   activity.max = 0.0;
-   activity.ninfmin = 0;
-   activity.ninfmax = 0;
-   activity.lastchange = presolveround;
-
    for( int j = 0; j < rowlen; ++j )
    {
       int col = colindices[j];
@@ -218,9 +219,211 @@ compute_row_activity( const REAL* rowvals, const int* colindices, int rowlen,
             ++activity.ninfmin;
       }
    }
+}
+
+template <typename REAL>
+RowActivity<REAL>
+compute_row_activity( const REAL* rowvals, const int* colindices, int rowlen,
+                      const Vec<REAL>& lower_bounds,
+                      const Vec<REAL>& upper_bounds, const Vec<ColFlags>& flags,
+                      int presolveround = -1 )
+{
+   RowActivity<REAL> activity;
+
+   activity.min = 0.0;
+   activity.max = 0.0;
+   activity.ninfmin = 0;
+   activity.ninfmax = 0;
+   activity.lastchange = presolveround;
+
+   accumulate_row_activity( activity, rowvals, colindices, rowlen,
+                            lower_bounds, upper_bounds, flags );
+
+   return activity;
+}
+
+#if defined( __AVX512F__ ) || defined( __AVX2__ )
+/// double precision specialization that computes the activity of a row in
+/// vector lanes, gathering the bounds of the columns through the column
+/// indices. Each lane accumulates its own partial sums, so the result may
+/// differ from the scalar kernel in the last bits due to the different
+/// summation order.
+template <>
+inline RowActivity<double>
+compute_row_activity( const double* rowvals, const int* colindices, int rowlen,
+                      const Vec<double>& lower_bounds,
+                      const Vec<double>& upper_bounds,
+                      const Vec<ColFlags>& flags, int presolveround )
+{
+   RowActivity<double> activity;
+
+   activity.min = 0.0;
+   activity.max = 0.0;
+   activity.ninfmin = 0;
+   activity.ninfmax = 0;
+   activity.lastchange = presolveround;
+
+   static_assert( sizeof( ColFlags ) == 1,
+                  "column flags are expected to be stored in single bytes" );
+
+   const double* lbs = lower_bounds.data();
+   const double* ubs = upper_bounds.data();
+   const char* rawflags = reinterpret_cast<const char*>( flags.data() );
+   int j = 0;
+
+#if defined( __AVX512F__ )
+   constexpr int nlanes = 8;
+
+   if( rowlen >= nlanes )
+   {
+      const __m512d zero = _mm512_setzero_pd();
+      const __m512i lbuselessbits = _mm512_set1_epi64(
+          static_cast<long long>( ColFlag::kLbUseless ) );
+      const __m512i ubuselessbits = _mm512_set1_epi64(
+          static_cast<long long>( ColFlag::kUbUseless ) );
+      __m512d vmin = zero;
+      __m512d vmax = zero;
+
+      for( ; j + nlanes <= rowlen; j += nlanes )
+      {
+         const __m256i idx = _mm256_loadu_si256(
+             reinterpret_cast<const __m256i*>( colindices + j ) );
+         const __m512d val = _mm512_loadu_pd( rowvals + j );
+
+         const __m512i cflags = _mm512_cvtepu8_epi64( _mm_setr_epi8(
+             rawflags[colindices[j]], rawflags[colindices[j + 1]],
+             rawflags[colindices[j + 2]], rawflags[colindices[j + 3]],
+             rawflags[colindices[j + 4]], rawflags[colindices[j + 5]],
+             rawflags[colindices[j + 6]], rawflags[colindices[j + 7]], 0, 0,
+             0, 0, 0, 0, 0, 0 ) );
+         const __mmask8 lbuseless =
+             _mm512_test_epi64_mask( cflags, lbuselessbits );
+         const __mmask8 ubuseless =
+             _mm512_test_epi64_mask( cflags, ubuselessbits );
+
+         const __mmask8 neg = _mm512_cmp_pd_mask( val, zero, _CMP_LT_OQ );
+         const __mmask8 pos = __mmask8( ~neg );
+
+         const __m512d ubcontrib = _mm512_maskz_mul_pd(
+             __mmask8( ~ubuseless ), val,
+             _mm512_mask_i32gather_pd( zero, __mmask8( ~ubuseless ), idx,
+                                       ubs, 8 ) );
+         const __m512d lbcontrib = _mm512_maskz_mul_pd(
+             __mmask8( ~lbuseless ), val,
+             _mm512_mask_i32gather_pd( zero, __mmask8( ~lbuseless ), idx,
+                                       lbs, 8 ) );
+
+         vmin = _mm512_mask_add_pd( vmin, neg, vmin, ubcontrib );
+         vmax = _mm512_mask_add_pd( vmax, pos, vmax, ubcontrib );
+         vmax = _mm512_mask_add_pd( vmax, neg, vmax, lbcontrib );
+         vmin = _mm512_mask_add_pd( vmin, pos, vmin, lbcontrib );
+
+         activity.ninfmin += static_cast<int>(
+             std::bitset<nlanes>( ( neg & ubuseless ) | ( pos & lbuseless ) )
+                 .count() );
+         activity.ninfmax += static_cast<int>(
+             std::bitset<nlanes>( ( pos & ubuseless ) | ( neg & lbuseless ) )
+                 .count() );
+      }
+
+      alignas( 64 ) double lanemin[nlanes];
+      alignas( 64 ) double lanemax[nlanes];
+      _mm512_store_pd( lanemin, vmin );
+      _mm512_store_pd( lanemax, vmax );
+
+      for( int k = 0; k != nlanes; ++k )
+      {
+         activity.min += lanemin[k];
+         activity.max += lanemax[k];
+      }
+   }
+#else
+   constexpr int nlanes = 4;
+
+   if( rowlen >= nlanes )
+   {
+      const __m256d zero = _mm256_setzero_pd();
+      __m256d vmin = zero;
+      __m256d vmax = zero;
+      // the counters are kept in 64 bit lanes and decremented by the all-ones
+      // comparison masks
+      __m256i vninfmin = _mm256_setzero_si256();
+      __m256i vninfmax = _mm256_setzero_si256();
+
+      const __m256i allones = _mm256_set1_epi64x( -1 );
+      const __m256i lbuselessbits = _mm256_set1_epi64x(
+          static_cast<long long>( ColFlag::kLbUseless ) );
+      const __m256i ubuselessbits = _mm256_set1_epi64x(
+          static_cast<long long>( ColFlag::kUbUseless ) );
+
+      for( ; j + nlanes <= rowlen; j += nlanes )
+      {
+         const __m128i idx = _mm_loadu_si128(
+             reinterpret_cast<const __m128i*>( colindices + j ) );
+         const __m256d val = _mm256_loadu_pd( rowvals + j );
+         const __m256i cflags = _mm256_cvtepu8_epi64( _mm_setr_epi8(
+             rawflags[colindices[j]], rawflags[colindices[j + 1]],
+             rawflags[colindices[j + 2]], rawflags[colindices[j + 3]], 0, 0,
+             0, 0, 0, 0, 0, 0, 0, 0, 0, 0 ) );
+         const __m256d lbuseless = _mm256_castsi256_pd( _mm256_xor_si256(
+             _mm256_cmpeq_epi64( _mm256_and_si256( cflags, lbuselessbits ),
+                                 _mm256_setzero_si256() ),
+             allones ) );
+         const __m256d ubuseless = _mm256_castsi256_pd( _mm256_xor_si256(
+             _mm256_cmpeq_epi64( _mm256_and_si256( cflags, ubuselessbits ),
+                                 _mm256_setzero_si256() ),
+             allones ) );
+         const __m256d neg = _mm256_cmp_pd( val, zero, _CMP_LT_OQ );
+
+         // useless bounds may be infinite, hence their products are masked
+         // out instead of being multiplied by zero
+         const __m256d ubcontrib = _mm256_andnot_pd(
+             ubuseless,
+             _mm256_mul_pd( val, _mm256_i32gather_pd( ubs, idx, 8 ) ) );
+         const __m256d lbcontrib = _mm256_andnot_pd(
+             lbuseless,
+             _mm256_mul_pd( val, _mm256_i32gather_pd( lbs, idx, 8 ) ) );
+
+         vmin = _mm256_add_pd( vmin, _mm256_and_pd( neg, ubcontrib ) );
+         vmax = _mm256_add_pd( vmax, _mm256_andnot_pd( neg, ubcontrib ) );
+         vmax = _mm256_add_pd( vmax, _mm256_and_pd( neg, lbcontrib ) );
+         vmin = _mm256_add_pd( vmin, _mm256_andnot_pd( neg, lbcontrib ) );
+
+         vninfmin = _mm256_sub_epi64(
+             vninfmin, _mm256_castpd_si256(
+                           _mm256_blendv_pd( lbuseless, ubuseless, neg ) ) );
+         vninfmax = _mm256_sub_epi64(
+             vninfmax, _mm256_castpd_si256(
+                           _mm256_blendv_pd( ubuseless, lbuseless, neg ) ) );
+      }
+
+      alignas( 32 ) double lanemin[nlanes];
+      alignas( 32 ) double lanemax[nlanes];
+      alignas( 32 ) long long laneninfmin[nlanes];
+      alignas( 32 ) long long laneninfmax[nlanes];
+      _mm256_store_pd( lanemin, vmin );
+      _mm256_store_pd( lanemax, vmax );
+      _mm256_store_si256( reinterpret_cast<__m256i*>( laneninfmin ),
+                          vninfmin );
+      _mm256_store_si256( reinterpret_cast<__m256i*>( laneninfmax ),
+                          vninfmax );
+
+      for( int k = 0; k != nlanes; ++k )
+      {
+         activity.min += lanemin[k];
+         activity.max += lanemax[k];
+         activity.ninfmin += static_cast<int>( laneninfmin[k] );
+         activity.ninfmax += static_cast<int>( laneninfmax[k] );
+      }
+   }
+#endif
+
+   accumulate_row_activity( activity, rowvals + j, colindices + j, rowlen - j,
+                            lower_bounds, upper_bounds, flags );
 
    return activity;
 }
+#endif
 
 template <typename REAL>
 REAL
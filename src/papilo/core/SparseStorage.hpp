@@ -26,15 +26,29 @@
 #include "papilo/misc/MultiPrecision.hpp"
 #include "papilo/misc/Vec.hpp"
 #include "papilo/external/pdqsort/pdqsort.h"
+#ifdef PAPILO_TBB
+#include "papilo/misc/tbb.hpp"
+#endif
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <tuple>
 
 namespace papilo
 {
 
+/// integer type used for positions inside the value and index arrays of the
+/// sparse storages. Row and column indices are always of type int, but because
+/// of the spare space between the rows the allocated size of the arrays can
+/// exceed the range of int well before the number of nonzeros does
+#ifdef PAPILO_LONG_NNZ_INDEX
+using NnzIndex = int64_t;
+#else
+using NnzIndex = int;
+#endif
+
 /// type definition for a non-zero entry in triplet format
 template <typename REAL>
 using Triplet = std::tuple<int, int, REAL>;
@@ -46,8 +60,8 @@ class ConstraintMatrix;
 
 struct IndexRange
 {
-   int start;
-   int end;
+   NnzIndex start;
+   NnzIndex end;
 
    IndexRange() : start( -1 ), end( -1 ){};
 
@@ -76,12 +90,12 @@ class SparseStorage
    SparseStorage( Vec<Triplet<REAL>> entries, int nRows_in, int nCols_in,
                   bool sorted = false, double spareRatio = DEFAULT_SPARE_RATIO,
                   int minInterRowSpace = DEFAULT_MIN_INTER_ROW_SPACE );
-   SparseStorage( REAL* values_in, int* rowstart_in, int* columns_in,
-                  int nRows_in, int nCols_in, int nnz_in,
+   SparseStorage( REAL* values_in, NnzIndex* rowstart_in, int* columns_in,
+                  int nRows_in, int nCols_in, NnzIndex nnz_in,
                   double spareRatio = DEFAULT_SPARE_RATIO,
                   int minInterRowSpace = DEFAULT_MIN_INTER_ROW_SPACE );
-   SparseStorage( int nRows_in, int nCols_in, int nnz_in, double spareRatio,
-                  int minInterRowSpace );
+   SparseStorage( int nRows_in, int nCols_in, NnzIndex nnz_in,
+                  double spareRatio, int minInterRowSpace );
 
    SparseStorage<REAL>
    getTranspose() const;
@@ -106,19 +120,19 @@ class SparseStorage
       return nCols;
    }
 
-   int
+   NnzIndex
    getNnz() const
    {
       return nnz;
    }
 
-   int&
+   NnzIndex&
    getNnz()
    {
       return nnz;
    }
 
-   int
+   NnzIndex
    getNAlloc() const
    {
       return nAlloc;
@@ -178,7 +192,7 @@ class SparseStorage
       return columns;
    }
 
-   Vec<int>
+   Vec<NnzIndex>
    getRowStarts() const;
 
    // function to change existing coefficients in row. Must not be called with
@@ -189,7 +203,7 @@ class SparseStorage
    changeRowInplace( int row, HasNext&& hasNext, GetNext&& getNext,
                      CoeffChanged&& coeffChanged )
    {
-      int i = rowranges[row].start;
+      NnzIndex i = rowranges[row].start;
       int j = 0;
 
       while( hasNext() )
@@ -271,7 +285,7 @@ class SparseStorage
       valbuffer.reserve( rowmaxlen );
       indbuffer.reserve( rowmaxlen );
 
-      int i = rowranges[row].start;
+      NnzIndex i = rowranges[row].start;
 
       while( i != rowranges[row].end && it != itend )
       {
@@ -378,7 +392,7 @@ class SparseStorage
 
       for( int i = 0; i != nRows; ++i )
       {
-         for( int j = rowranges[i].start; j != rowranges[i].end; ++j )
+         for( NnzIndex j = rowranges[i].start; j != rowranges[i].end; ++j )
          {
             ar& values[j];
             ar& columns[j];
@@ -393,20 +407,54 @@ class SparseStorage
    }
 
  private:
-   int
+   /// minimal number of nonzeros per block of rows for getTranspose() and
+   /// compress() to process the blocks in parallel
+   static constexpr NnzIndex MIN_PARALLEL_BLOCK_NNZ = 1 << 15;
+
+   NnzIndex
    computeNAlloc() const
    {
-      return static_cast<int>( nnz * spareRatio ) + nRows * minInterRowSpace;
+      return static_cast<NnzIndex>( nnz * spareRatio ) +
+             NnzIndex{ nRows } * minInterRowSpace;
+   }
+
+   /// splits the rows into consecutive blocks of roughly the same allocated
+   /// size, one per available thread but at most maxblocks, and returns the
+   /// first row of each block followed by nRows
+   Vec<int>
+   computeRowBlocks( int maxblocks = std::numeric_limits<int>::max() ) const;
+
+   template <typename BlockFunc>
+   static void
+   forEachBlock( int nblocks, BlockFunc&& blockFunc )
+   {
+#ifdef PAPILO_TBB
+      if( nblocks > 1 )
+      {
+         tbb::parallel_for( tbb::blocked_range<int>( 0, nblocks, 1 ),
+                            [&]( const tbb::blocked_range<int>& r ) {
+                               for( int b = r.begin(); b != r.end(); ++b )
+                                  blockFunc( b );
+                            } );
+         return;
+      }
+#endif
+      for( int b = 0; b < nblocks; ++b )
+         blockFunc( b );
    }
 
+   void
+   compressRowsParallel( const Vec<int>& rowsize, const Vec<int>& colsmap,
+                         const Vec<int>& blocks, bool full );
+
    Vec<REAL> values;
    Vec<IndexRange> rowranges;
    Vec<int> columns;
 
    int nRows = -1;
    int nCols = -1;
-   int nnz = -1;
-   int nAlloc = -1;
+   NnzIndex nnz = -1;
+   NnzIndex nAlloc = -1;
    double spareRatio = 0.0;
    int minInterRowSpace = 0;
 };
@@ -439,7 +487,7 @@ SparseStorage<REAL>::SparseStorage( Vec<Triplet<REAL>> entries, int nRows_in,
 
    rowranges[0].start = 0;
 
-   int idx = 0;
+   NnzIndex idx = 0;
    int current_row = 0;
    for( auto entry : entries )
    {
@@ -507,8 +555,9 @@ SparseStorage<REAL>::SparseStorage( Vec<Triplet<REAL>> entries, int nRows_in,
 }
 
 template <typename REAL>
-SparseStorage<REAL>::SparseStorage( int nRows_in, int nCols_in, int nnz_in,
-                                    double spareRatio_, int minInterRowSpace_ )
+SparseStorage<REAL>::SparseStorage( int nRows_in, int nCols_in,
+                                    NnzIndex nnz_in, double spareRatio_,
+                                    int minInterRowSpace_ )
     : nRows( nRows_in ), nCols( nCols_in ), nnz( nnz_in ),
       spareRatio( spareRatio_ ), minInterRowSpace( minInterRowSpace_ )
 {
@@ -524,9 +573,9 @@ SparseStorage<REAL>::SparseStorage( int nRows_in, int nCols_in, int nnz_in,
 }
 
 template <typename REAL>
-SparseStorage<REAL>::SparseStorage( REAL* values_in, int* rowstart_in,
+SparseStorage<REAL>::SparseStorage( REAL* values_in, NnzIndex* rowstart_in,
                                     int* columns_in, int nRows_in, int nCols_in,
-                                    int nnz_in, double spareRatio_in,
+                                    NnzIndex nnz_in, double spareRatio_in,
                                     int minInterRowSpace_in )
     : nRows( nRows_in ), nCols( nCols_in ), nnz( nnz_in ),
       spareRatio( spareRatio_in ), minInterRowSpace( minInterRowSpace_in )
@@ -542,12 +591,12 @@ SparseStorage<REAL>::SparseStorage( REAL* values_in, int* rowstart_in,
    rowranges.resize( nRows + 1 );
 
    // build storage
-   int shift = 0;
+   NnzIndex shift = 0;
    for( int r = 0; r < nRows; r++ )
    {
       rowranges[r].start = rowstart_in[r] + shift;
 
-      for( int j = rowstart_in[r]; j < rowstart_in[r + 1]; j++ )
+      for( NnzIndex j = rowstart_in[r]; j < rowstart_in[r + 1]; j++ )
       {
          if( values_in[j] != REAL{ 0.0 } )
          {
@@ -581,64 +630,102 @@ SparseStorage<REAL>::getTranspose() const
 //   if( nCols <= 0 )
 //      return SparseStorage<REAL>{};
 
-   // compute nnz of each row of At (column of A)
+   // the rows of A are split into blocks that are processed in parallel.
+   // Each block counts its nonzeros per column of A and afterwards fills its
+   // own consecutive slice of every row of At, which yields the same layout
+   // as processing the rows one after another
+   // every block needs its own count per column, hence the blocks are
+   // limited such that the counts take at most as much memory as the nonzeros
+   const Vec<int> blocks = computeRowBlocks( static_cast<int>(
+       std::max( nCols > 0 ? nnz / nCols : NnzIndex{ 1 }, NnzIndex{ 1 } ) ) );
+   const int nblocks = static_cast<int>( blocks.size() ) - 1;
 
-   Vec<int> w( size_t( nCols ), 0 );
+   // compute nnz of each row of At (column of A) per block
+   Vec<NnzIndex> w( size_t( nCols ) * nblocks, 0 );
 
-   for( int r = 0; r < nRows; r++ )
-   {
-      const int start = rowranges[r].start;
-      const int end = rowranges[r].end;
+   forEachBlock( nblocks, [&]( int b ) {
+      NnzIndex* count = w.data() + size_t( nCols ) * b;
 
-      for( int j = start; j < end; j++ )
+      for( int r = blocks[b]; r < blocks[b + 1]; r++ )
       {
-         assert( values[j] != REAL{ 0.0 } );
-         w[columns[j]]++;
+         const NnzIndex start = rowranges[r].start;
+         const NnzIndex end = rowranges[r].end;
+
+         for( NnzIndex j = start; j < end; j++ )
+         {
+            assert( values[j] != REAL{ 0.0 } );
+            count[columns[j]]++;
+         }
       }
-   }
+   } );
 
    assert( spareRatio >= 1.0 );
 
    SparseStorage<REAL> transpose{ nCols, nRows, nnz, spareRatio,
                                   minInterRowSpace };
 
-   // set row ranges of transpose
-   transpose.rowranges[0].start = 0;
+   // set row ranges of transpose and turn the counts into the position of
+   // each block inside the rows of the transpose. The counts are traversed
+   // block by block, such that the accesses are contiguous
+   IndexRange* ranges = transpose.rowranges.data();
 
-   for( int i = 1; i <= nCols; i++ )
+   for( int i = 0; i < nCols; i++ )
+      ranges[i].end = 0;
+
+   for( int b = 0; b < nblocks; b++ )
    {
-      const int oldstart = transpose.rowranges[i - 1].start;
-      const int oldend = oldstart + w[i - 1];
-      assert( oldend >= oldstart );
+      const NnzIndex* count = w.data() + size_t( nCols ) * b;
+      for( int i = 0; i < nCols; i++ )
+         ranges[i].end += count[i];
+   }
 
-      transpose.rowranges[i - 1].end = oldend;
-      transpose.rowranges[i].start =
-          oldstart + transpose.computeRowAlloc( w[i - 1] );
+   ranges[0].start = 0;
 
-      w[i - 1] = oldstart;
+   for( int i = 0; i < nCols; i++ )
+   {
+      const int size = static_cast<int>( ranges[i].end );
+      ranges[i].end = ranges[i].start;
+      ranges[i + 1].start =
+          ranges[i].start + transpose.computeRowAlloc( size );
+   }
+
+   for( int b = 0; b < nblocks; b++ )
+   {
+      NnzIndex* pos = w.data() + size_t( nCols ) * b;
+      for( int i = 0; i < nCols; i++ )
+      {
+         const NnzIndex count = pos[i];
+         pos[i] = ranges[i].end;
+         ranges[i].end += count;
+      }
    }
 
    transpose.rowranges[nCols].start = transpose.nAlloc;
    transpose.rowranges[nCols].end = transpose.nAlloc;
 
    // fill values and columns arrays of transpose
-   for( int r = 0; r < nRows; r++ )
-   {
-      const int start = rowranges[r].start;
-      const int end = rowranges[r].end;
+   forEachBlock( nblocks, [&]( int b ) {
+      NnzIndex* pos = w.data() + size_t( nCols ) * b;
 
-      for( int j = start; j < end; j++ )
+      for( int r = blocks[b]; r < blocks[b + 1]; r++ )
       {
-         const int idx = w[columns[j]];
+         const NnzIndex start = rowranges[r].start;
+         const NnzIndex end = rowranges[r].end;
+
+         for( NnzIndex j = start; j < end; j++ )
+         {
+            const NnzIndex idx = pos[columns[j]];
 
-         assert( idx < transpose.nAlloc );
+            assert( idx < transpose.nAlloc );
 
-         transpose.values[idx] = values[j];
-         transpose.columns[idx] = r;
+            transpose.values[idx] = values[j];
+            transpose.columns[idx] = r;
 
-         w[columns[j]] = idx + 1;
+            pos[columns[j]] = idx + 1;
+         }
       }
-   }
+   } );
+
    return transpose;
 }
 
@@ -672,13 +759,22 @@ SparseStorage<REAL>::compress( const Vec<int>& rowsize, const Vec<int>& colsize,
 
    if( nRows > 0 )
    {
-      int offset = 0;
+#ifdef PAPILO_TBB
+      const Vec<int> blocks = computeRowBlocks();
+      if( blocks.size() > 2 )
+      {
+         compressRowsParallel( rowsize, colsmap, blocks, full );
+         return colsmap;
+      }
+#endif
+
+      NnzIndex offset = 0;
       int rowcount = 0;
       for( int r = 0; r < nRows; r++ )
       {
-         const int start = rowranges[r].start;
-         const int end = rowranges[r].end;
-         const int rowalloc = rowranges[r + 1].start - start;
+         const NnzIndex start = rowranges[r].start;
+         const NnzIndex end = rowranges[r].end;
+         const NnzIndex rowalloc = rowranges[r + 1].start - start;
 
          // empty row?
          if( rowsize[r] == -1 )
@@ -704,7 +800,7 @@ SparseStorage<REAL>::compress( const Vec<int>& rowsize, const Vec<int>& colsize,
                rowranges[rowcount].end -= offset;
             }
 
-            offset = std::max(
+            offset = std::max<NnzIndex>(
                 offset + rowalloc - computeRowAlloc( end - start ), 0 );
 
             ++rowcount;
@@ -733,10 +829,10 @@ SparseStorage<REAL>::compress( const Vec<int>& rowsize, const Vec<int>& colsize,
 
       for( int r = 0; r < nRows; r++ )
       {
-         const int start = rowranges[r].start;
-         const int end = rowranges[r].end;
+         const NnzIndex start = rowranges[r].start;
+         const NnzIndex end = rowranges[r].end;
 
-         for( int j = start; j < end; j++ )
+         for( NnzIndex j = start; j < end; j++ )
          {
             assert( columns[j] >= 0 );
             assert( columns[j] < static_cast<int>( colsmap.size() ) );
@@ -750,6 +846,173 @@ SparseStorage<REAL>::compress( const Vec<int>& rowsize, const Vec<int>& colsize,
    return colsmap;
 }
 
+template <typename REAL>
+void
+SparseStorage<REAL>::compressRowsParallel( const Vec<int>& rowsize,
+                                           const Vec<int>& colsmap,
+                                           const Vec<int>& blocks, bool full )
+{
+   // compute the new row ranges exactly like the sequential compression
+   Vec<IndexRange> newranges;
+   Vec<int> newrow( size_t( nRows ), -1 );
+   newranges.reserve( nRows + 1 );
+
+   NnzIndex offset = 0;
+   for( int r = 0; r < nRows; r++ )
+   {
+      const NnzIndex start = rowranges[r].start;
+      const NnzIndex end = rowranges[r].end;
+      const NnzIndex rowalloc = rowranges[r + 1].start - start;
+
+      // empty row?
+      if( rowsize[r] == -1 )
+         offset += rowalloc;
+      else
+      {
+         newrow[r] = static_cast<int>( newranges.size() );
+         newranges.emplace_back();
+         newranges.back().start = start - offset;
+         newranges.back().end = end - offset;
+
+         offset = std::max<NnzIndex>(
+             offset + rowalloc -
+                 computeRowAlloc( static_cast<int>( end - start ) ),
+             0 );
+      }
+
+      assert( offset <= nAlloc );
+   }
+
+   newranges.emplace_back();
+   newranges.back().start = rowranges[nRows].start - offset;
+   newranges.back().end = rowranges[nRows].end - offset;
+
+   const NnzIndex newNAlloc = nAlloc - offset;
+   assert( newNAlloc >= 0 );
+
+   // the rows only move to the left, so each block compacts its rows in
+   // place. Only the first rows of a block may move below the start of the
+   // block and overwrite rows of the previous block that were not moved yet.
+   // These rows are buffered and written after all blocks moved their rows.
+   const int nblocks = static_cast<int>( blocks.size() ) - 1;
+   Vec<Vec<REAL>> buffervalues( nblocks );
+   Vec<Vec<int>> buffercolumns( nblocks );
+   Vec<int> firstinplace( nblocks );
+
+   forEachBlock( nblocks, [&]( int b ) {
+      const NnzIndex blockstart = rowranges[blocks[b]].start;
+      int r = blocks[b];
+
+      for( ; r < blocks[b + 1]; r++ )
+      {
+         if( newrow[r] == -1 )
+            continue;
+         if( newranges[newrow[r]].start >= blockstart )
+            break;
+
+         for( NnzIndex j = rowranges[r].start; j < rowranges[r].end; j++ )
+         {
+            assert( columns[j] >= 0 );
+            assert( columns[j] < static_cast<int>( colsmap.size() ) );
+            buffervalues[b].push_back( std::move( values[j] ) );
+            buffercolumns[b].push_back( colsmap[columns[j]] );
+         }
+      }
+
+      firstinplace[b] = r;
+
+      for( ; r < blocks[b + 1]; r++ )
+      {
+         if( newrow[r] == -1 )
+            continue;
+
+         NnzIndex k = newranges[newrow[r]].start;
+         assert( k <= rowranges[r].start );
+
+         for( NnzIndex j = rowranges[r].start; j < rowranges[r].end;
+              j++, k++ )
+         {
+            assert( columns[j] >= 0 );
+            assert( columns[j] < static_cast<int>( colsmap.size() ) );
+            if( k != j )
+               values[k] = std::move( values[j] );
+            columns[k] = colsmap[columns[j]];
+            assert( columns[k] >= 0 );
+            assert( columns[k] < nCols );
+         }
+      }
+   } );
+
+   forEachBlock( nblocks, [&]( int b ) {
+      std::size_t pos = 0;
+
+      for( int r = blocks[b]; r < firstinplace[b]; r++ )
+      {
+         if( newrow[r] == -1 )
+            continue;
+
+         for( NnzIndex k = newranges[newrow[r]].start;
+              k < newranges[newrow[r]].end; k++, pos++ )
+         {
+            values[k] = std::move( buffervalues[b][pos] );
+            columns[k] = buffercolumns[b][pos];
+            assert( columns[k] >= 0 );
+            assert( columns[k] < nCols );
+         }
+      }
+
+      assert( pos == buffervalues[b].size() );
+   } );
+
+   nRows = static_cast<int>( newranges.size() ) - 1;
+   nAlloc = newNAlloc;
+   rowranges = std::move( newranges );
+   values.resize( nAlloc );
+   columns.resize( nAlloc );
+
+   if( full )
+   {
+      rowranges.shrink_to_fit();
+      values.shrink_to_fit();
+      columns.shrink_to_fit();
+   }
+}
+
+template <typename REAL>
+Vec<int>
+SparseStorage<REAL>::computeRowBlocks( int maxblocks ) const
+{
+   int nblocks = 1;
+
+#ifdef PAPILO_TBB
+   nblocks = static_cast<int>(
+       std::min( { NnzIndex( tbb::this_task_arena::max_concurrency() ),
+                   nnz / MIN_PARALLEL_BLOCK_NNZ, NnzIndex( nRows ),
+                   NnzIndex( maxblocks ) } ) );
+   nblocks = std::max( nblocks, 1 );
+#endif
+
+   Vec<int> blocks( size_t( nblocks ) + 1 );
+   blocks[0] = 0;
+
+   for( int b = 1; b < nblocks; ++b )
+   {
+      const NnzIndex pos =
+          static_cast<NnzIndex>( int64_t( rowranges[nRows].start ) * b /
+                                 nblocks );
+      blocks[b] = static_cast<int>(
+          std::lower_bound( rowranges.begin(), rowranges.begin() + nRows, pos,
+                            []( const IndexRange& range, NnzIndex p ) {
+                               return range.start < p;
+                            } ) -
+          rowranges.begin() );
+   }
+
+   blocks[nblocks] = nRows;
+
+   return blocks;
+}
+
 template <typename REAL>
 bool
 SparseStorage<REAL>::shiftRows( const int* rowinds, int ninds,
@@ -764,7 +1027,7 @@ SparseStorage<REAL>::shiftRows( const int* rowinds, int ninds,
    for( int i = 0; i != ninds; ++i )
    {
       const int row = rowinds[i];
-      int missingspace = requiredSpareSpace[i] -
+      NnzIndex missingspace = requiredSpareSpace[i] -
                          ( rowranges[row + 1].start - rowranges[row].end );
       if( missingspace > 0 )
       {
@@ -773,16 +1036,16 @@ SparseStorage<REAL>::shiftRows( const int* rowinds, int ninds,
 
          int l = row;
          int r = row + 1;
-         int lastshiftleft = 0;
-         int lastshiftright = 0;
+         NnzIndex lastshiftleft = 0;
+         NnzIndex lastshiftright = 0;
          int maxshift = maxshiftperrow;
          while( missingspace > 0 )
          {
             if( l > leftbound && r < rightbound )
             {
-               int nspaceleft = std::min(
+               NnzIndex nspaceleft = std::min(
                    missingspace, rowranges[l].start - rowranges[l - 1].end );
-               int nspaceright = std::min(
+               NnzIndex nspaceright = std::min(
                    missingspace, rowranges[r + 1].start - rowranges[r].end );
                int nshiftleft = rowranges[l].end - rowranges[l].start;
                int nshiftright = rowranges[r].end - rowranges[r].start;
@@ -865,7 +1128,7 @@ SparseStorage<REAL>::shiftRows( const int* rowinds, int ninds,
 
             while( l <= row )
             {
-               int shift = &values[rowranges[l].start] - valsout;
+               NnzIndex shift = &values[rowranges[l].start] - valsout;
 
 #ifndef NDEBUG
                Vec<REAL> tmpvals;
@@ -915,7 +1178,7 @@ SparseStorage<REAL>::shiftRows( const int* rowinds, int ninds,
 
             while( r > row )
             {
-               int shift = valsout - &values[rowranges[r].end];
+               NnzIndex shift = valsout - &values[rowranges[r].end];
 
 #ifndef NDEBUG
                Vec<REAL> tmpvals;
@@ -964,11 +1227,11 @@ SparseStorage<REAL>::shiftRows( const int* rowinds, int ninds,
 }
 
 template <typename REAL>
-Vec<int>
+Vec<NnzIndex>
 SparseStorage<REAL>::getRowStarts() const
 {
    int size = getNRows() + 1;
-   Vec<int> colStart( size );
+   Vec<NnzIndex> colStart( size );
 
    unsigned int i;
    for( i = 0; i < colStart.size() - 1; ++i )
@@ -58,6 +58,22 @@ struct Statistics
          consecutive_rounds_of_only_boundchanges( 0 )
    {
    }
+
+   template <typename Archive>
+   void
+   serialize( Archive& ar, const unsigned int version )
+   {
+      ar& presolvetime;
+      ar& ntsxapplied;
+      ar& ntsxconflicts;
+      ar& nboundchgs;
+      ar& nsidechgs;
+      ar& ncoefchgs;
+      ar& nrounds;
+      ar& ndeletedcols;
+      ar& ndeletedrows;
+      ar& consecutive_rounds_of_only_boundchanges;
+   }
 };
 
 inline Statistics
@@ -105,32 +105,32 @@ class Postsolve
    int
    apply_fix_infinity_variable_in_original_solution(
        Solution<REAL>& originalSolution, Vec<int>& indices, Vec<REAL>& values,
-       int first, const Problem<REAL>& problem,
+       NnzIndex first, const Problem<REAL>& problem,
        BoundStorage<REAL>& stored_bounds ) const;
 
    void
    apply_var_bound_change_forced_by_column_in_original_solution(
        Solution<REAL>& originalSolution, const Vec<ReductionType>& types,
-       const Vec<int>& start, const Vec<int>& indices, const Vec<REAL>& values,
-       int i, int first, BoundStorage<REAL>& stored_bounds, bool is_optimal  ) const;
+       const Vec<NnzIndex>& start, const Vec<int>& indices, const Vec<REAL>& values,
+       int i, NnzIndex first, BoundStorage<REAL>& stored_bounds, bool is_optimal  ) const;
 
    void
    apply_parallel_col_to_original_solution( Solution<REAL>& originalSolution,
                                             const Vec<int>& indices,
-                                            const Vec<REAL>& values, int first,
-                                            int last,
+                                            const Vec<REAL>& values, NnzIndex first,
+                                            NnzIndex last,
                                             BoundStorage<REAL>& stored ) const;
 
    void
    apply_row_bound_change_to_original_solution(
        Solution<REAL>& originalSolution, const Vec<ReductionType>& types,
-       const Vec<int>& start, const Vec<int>& indices, const Vec<REAL>& values,
-       int i, int first ) const;
+       const Vec<NnzIndex>& start, const Vec<int>& indices, const Vec<REAL>& values,
+       int i, NnzIndex first ) const;
 
    void
    apply_substituted_column_to_original_solution(
        Solution<REAL>& originalSolution, const Vec<int>& indices,
-       const Vec<REAL>& values, int first, int last,
+       const Vec<REAL>& values, NnzIndex first, NnzIndex last,
        BoundStorage<REAL>& stored, bool is_optimal ) const;
 
    VarBasisStatus
@@ -143,7 +143,7 @@ class Postsolve
    void
    remove_row_from_basis( Solution<REAL>& originalSolution,
                           const Vec<ReductionType>& types,
-                          const Vec<int>& start, const Vec<int>& indices,
+                          const Vec<NnzIndex>& start, const Vec<int>& indices,
                           const Vec<REAL>& values, int i,
                           BoundStorage<REAL>& stored_bounds,
                           bool is_optimal ) const;
@@ -162,7 +162,7 @@ class Postsolve
 
    bool
    skip_if_row_bound_belongs_to_substitution( const Vec<ReductionType>& types,
-                                              const Vec<int>& start,
+                                              const Vec<NnzIndex>& start,
                                               const Vec<int>& indices,
                                               const Vec<REAL>& values, int i,
                                               int row ) const;
@@ -204,8 +204,8 @@ Postsolve<REAL>::undo( const Solution<REAL>& reducedSolution,
    for( int i = (int) postsolveStorage.types.size() - 1; i >= 0; --i )
    {
       auto type = types[i];
-      int first = start[i];
-      int last = start[i + 1];
+      NnzIndex first = start[i];
+      NnzIndex last = start[i + 1];
 
       //check which type is done:
       // - calculate the primal solution
@@ -263,7 +263,7 @@ Postsolve<REAL>::undo( const Solution<REAL>& reducedSolution,
          REAL side = values[first];
          REAL colCoef = 0.0;
          StableSum<REAL> sumcols;
-         for( int j = first + 1; j < last; ++j )
+         for( NnzIndex j = first + 1; j < last; ++j )
          {
             if( indices[j] == col )
                colCoef = values[j];
@@ -346,7 +346,7 @@ Postsolve<REAL>::undo( const Solution<REAL>& reducedSolution,
          for( unsigned int j = 0; j < postsolveStorage.origcol_mapping.size(); j++ )
          {
             int origCol = postsolveStorage.origcol_mapping[j];
-            int index = first + 2 * j;
+            NnzIndex index = first + 2 * j;
             stored_bounds.set_bounds_of_variable(
                 origCol, postsolveStorage.indices[index] == 1,
                 postsolveStorage.indices[index + 1] == 1,
@@ -355,12 +355,12 @@ Postsolve<REAL>::undo( const Solution<REAL>& reducedSolution,
          }
 
          // get row bounds
-         int first_row_bounds =
+         NnzIndex first_row_bounds =
              first + 2 * postsolveStorage.origcol_mapping.size();
          for( unsigned int k = 0; k < postsolveStorage.origrow_mapping.size(); k++ )
          {
             int origRow = postsolveStorage.origrow_mapping[k];
-            int index = first_row_bounds + 2 * k;
+            NnzIndex index = first_row_bounds + 2 * k;
             stored_bounds.set_bounds_of_row(
                 origRow, postsolveStorage.indices[index] == 1,
                 postsolveStorage.indices[index + 1] == 1,
@@ -429,7 +429,7 @@ Postsolve<REAL>::undo( const Solution<REAL>& reducedSolution,
 template <typename REAL>
 bool
 Postsolve<REAL>::skip_if_row_bound_belongs_to_substitution(
-    const Vec<ReductionType>& types, const Vec<int>& start,
+    const Vec<ReductionType>& types, const Vec<NnzIndex>& start,
     const Vec<int>& indices, const Vec<REAL>& values, int i, int row ) const
 {
    if( i >= 2 && types[i - 1] == ReductionType::kCoefficientChange &&
@@ -555,7 +555,7 @@ template <typename REAL>
 int
 Postsolve<REAL>::apply_fix_infinity_variable_in_original_solution(
     Solution<REAL>& originalSolution, Vec<int>& indices, Vec<REAL>& values,
-    int first, const Problem<REAL>& problem,
+    NnzIndex first, const Problem<REAL>& problem,
     BoundStorage<REAL>& stored_bounds ) const
 {
    // calculate the feasible (minimal) value for the infinity variable
@@ -564,7 +564,7 @@ Postsolve<REAL>::apply_fix_infinity_variable_in_original_solution(
    int number_rows = indices[first + 1];
    REAL solution = bound;
    int row_counter = 0;
-   int current_counter = first + 2;
+   NnzIndex current_counter = first + 2;
 
    bool isNegativeInfinity = values[first] < 0;
    int* row_indices = new int[number_rows];
@@ -683,7 +683,7 @@ template <typename REAL>
 void
 Postsolve<REAL>::apply_substituted_column_to_original_solution(
     Solution<REAL>& originalSolution, const Vec<int>& indices,
-    const Vec<REAL>& values, int first, int last,
+    const Vec<REAL>& values, NnzIndex first, NnzIndex last,
     BoundStorage<REAL>& stored, bool is_optimal ) const
 {
    int row = indices[first];
@@ -697,7 +697,7 @@ Postsolve<REAL>::apply_substituted_column_to_original_solution(
    // calculate the primal solution by solving the stored equation
    REAL colCoef = 0.0;
    StableSum<REAL> sumcols;
-   for( int j = first + 3; j < first + 3 + row_length; ++j )
+   for( NnzIndex j = first + 3; j < first + 3 + row_length; ++j )
    {
       if( indices[j] == col )
          colCoef = values[j];
@@ -742,7 +742,7 @@ Postsolve<REAL>::apply_substituted_column_to_original_solution(
          originalSolution.dual[row] += obj / colCoef;
 
          StableSum<REAL> sum_dual;
-         for( int j = first + 7 + row_length; j < last; ++j )
+         for( NnzIndex j = first + 7 + row_length; j < last; ++j )
             sum_dual.add( -originalSolution.dual[indices[j]] * values[j] );
          sum_dual.add( obj );
 
@@ -786,7 +786,7 @@ Postsolve<REAL>::apply_substituted_column_to_original_solution(
 
          REAL rowCoef = 0.0;
          StableSum<REAL> sum_dual;
-         for( int j = first + 7 + row_length; j < last; ++j )
+         for( NnzIndex j = first + 7 + row_length; j < last; ++j )
          {
             if( indices[j] == row )
                rowCoef = values[j];
@@ -833,8 +833,8 @@ template <typename REAL>
 void
 Postsolve<REAL>::apply_row_bound_change_to_original_solution(
     Solution<REAL>& originalSolution, const Vec<ReductionType>& types,
-    const Vec<int>& start, const Vec<int>& indices, const Vec<REAL>& values,
-    int i, int first ) const
+    const Vec<NnzIndex>& start, const Vec<int>& indices, const Vec<REAL>& values,
+    int i, NnzIndex first ) const
 {
    bool isLhs = indices[first] == 1;
    int row = (int)values[first];
@@ -844,7 +844,7 @@ Postsolve<REAL>::apply_row_bound_change_to_original_solution(
    //   bool was_infinity = indices[first + 2] == 1;
 
    int next_type = i - 1;
-   int start_reason = start[next_type];
+   NnzIndex start_reason = start[next_type];
    assert( types[next_type] ==
            ReductionType::kReasonForRowBoundChangeForcedByRow );
    int deleted_row = indices[start_reason + 1];
@@ -934,8 +934,8 @@ template <typename REAL>
 void
 Postsolve<REAL>::apply_var_bound_change_forced_by_column_in_original_solution(
     Solution<REAL>& originalSolution, const Vec<ReductionType>& types,
-    const Vec<int>& start, const Vec<int>& indices, const Vec<REAL>& values,
-    int i, int first, BoundStorage<REAL>& stored_bounds, bool is_optimal  ) const
+    const Vec<NnzIndex>& start, const Vec<int>& indices, const Vec<REAL>& values,
+    int i, NnzIndex first, BoundStorage<REAL>& stored_bounds, bool is_optimal  ) const
 {
 
    bool isLowerBound = indices[first] == 1;
@@ -1087,7 +1087,7 @@ template <typename REAL>
 void
 Postsolve<REAL>::apply_parallel_col_to_original_solution(
     Solution<REAL>& originalSolution, const Vec<int>& indices,
-    const Vec<REAL>& values, int first, int last,
+    const Vec<REAL>& values, NnzIndex first, NnzIndex last,
     BoundStorage<REAL>& stored ) const
 {
    // calculate values of the parallel cols such that at least one is at its
@@ -1314,7 +1314,7 @@ template <typename REAL>
 void
 Postsolve<REAL>::remove_row_from_basis( Solution<REAL>& originalSolution,
                                         const Vec<ReductionType>& types,
-                                        const Vec<int>& start,
+                                        const Vec<NnzIndex>& start,
                                         const Vec<int>& indices,
                                         const Vec<REAL>& values, int i, BoundStorage<REAL>& stored_bounds, bool is_optimal  ) const
 {
@@ -1385,7 +1385,7 @@ Postsolve<REAL>::recalculate_current_problem_from_the_original_problem(
    for( int j = 0; j < current_index; j++ )
    {
       auto type = types[j];
-      int first = start[j];
+      NnzIndex first = start[j];
       switch( type )
       {
       case ReductionType::kRedundantRow:
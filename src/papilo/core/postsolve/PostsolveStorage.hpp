@@ -78,7 +78,7 @@ class PostsolveStorage
 
    // indices where the information of the i-th reduction inside start/values starts
    // information go from [start[i], start [i+1])
-   Vec<int> start;
+   Vec<NnzIndex> start;
 
    Problem<REAL> problem;
 
@@ -212,6 +212,34 @@ class PostsolveStorage
 #endif
    }
 
+   /// appends the reductions and the reduced rows and columns of a storage
+   /// that presolved a part of the original problem which is disjoint from
+   /// all other parts, its mappings must refer to the original problem
+   void
+   append( const PostsolveStorage<REAL>& part )
+   {
+      assert( part.postsolveType == PostsolveType::kPrimal );
+      assert( types.size() + 1 == start.size() );
+      assert( part.types.size() + 1 == part.start.size() );
+
+      NnzIndex offset = start.back();
+      assert( offset == (NnzIndex)values.size() );
+
+      types.insert( types.end(), part.types.begin(), part.types.end() );
+      indices.insert( indices.end(), part.indices.begin(),
+                      part.indices.end() );
+      values.insert( values.end(), part.values.begin(), part.values.end() );
+      for( std::size_t i = 1; i < part.start.size(); ++i )
+         start.push_back( offset + part.start[i] );
+
+      origcol_mapping.insert( origcol_mapping.end(),
+                              part.origcol_mapping.begin(),
+                              part.origcol_mapping.end() );
+      origrow_mapping.insert( origrow_mapping.end(),
+                              part.origrow_mapping.begin(),
+                              part.origrow_mapping.end() );
+   }
+
    template <typename Archive>
    void
    serialize( Archive& ar, const unsigned int version )
@@ -54,13 +54,13 @@ class SavedRow
 
  public:
    SavedRow( const Num<REAL>& n, int i, const Vec<ReductionType>& types,
-             const Vec<int>& start, const Vec<int>& indices,
+             const Vec<NnzIndex>& start, const Vec<int>& indices,
              const Vec<REAL>& values, const Vec<REAL>& primal_solution )
    {
       int next_type = i - 1;
       int next_but_one_type = i - 2;
 
-      int saved_row = start[next_type];
+      NnzIndex saved_row = start[next_type];
       if( types[next_type] == ReductionType::kSaveRow )
          saved_row = start[next_type];
       else if( types[next_but_one_type] == ReductionType::kSaveRow )
@@ -23,7 +23,11 @@
 #ifndef _PAPILO_MISC_ALLOC_HPP_
 #define _PAPILO_MISC_ALLOC_HPP_
 
+#include "papilo/Config.hpp"
 #include <memory>
+#ifdef PAPILO_TBB_SCALABLE_ALLOCATOR
+#include "tbb/scalable_allocator.h"
+#endif
 
 namespace papilo
 {
@@ -31,8 +35,33 @@ namespace papilo
 template <typename T, int = 0>
 struct AllocatorTraits
 {
+#ifdef PAPILO_TBB_SCALABLE_ALLOCATOR
+   using type = tbb::scalable_allocator<T>;
+#else
    using type = std::allocator<T>;
+#endif
+};
+
+#ifdef PAPILO_TBB_SCALABLE_ALLOCATOR
+/// strings keep the standard allocator so that they interoperate with the
+/// standard library and the parsers
+template <>
+struct AllocatorTraits<char>
+{
+   using type = std::allocator<char>;
 };
+#endif
+
+/// name of the allocator used by the containers for the statistics output
+inline const char*
+getAllocatorName()
+{
+#ifdef PAPILO_TBB_SCALABLE_ALLOCATOR
+   return "tbb scalable";
+#else
+   return "std";
+#endif
+}
 
 template <typename T>
 using Allocator = typename AllocatorTraits<T>::type;
@@ -43,7 +43,8 @@ enum class Command
    kNone,
    kPresolve,
    kSolve,
-   kPostsolve
+   kPostsolve,
+   kBatch
 };
 
 struct ArithmeticType
@@ -75,10 +76,16 @@ struct OptionsInfo
    std::string soplex_settings_file;
    std::string param_settings_file;
    std::string objective_reference;
+   std::string instance_list_file;
+   std::string output_dir;
+   std::string checkpoint_file;
+   std::string resume_file;
+   std::string cache_dir;
    std::vector<std::string> unparsed_options;
    double tlim = std::numeric_limits<double>::max();
    char arithmetic_type = ArithmeticType::kDouble;
    int nthreads;
+   int ninstancethreads;
    bool print_stats;
    bool print_params;
    bool is_complete;
@@ -92,6 +99,18 @@ struct OptionsInfo
          return false;
       }
 
+      if( existsFile( resume_file ) )
+      {
+         fmt::print( "file {} is not valid\n", resume_file );
+         return false;
+      }
+
+      if( command == Command::kBatch && existsFile( instance_list_file ) )
+      {
+         fmt::print( "file {} is not valid\n", instance_list_file );
+         return false;
+      }
+
       if( command == Command::kPostsolve && existsFile(postsolve_archive_file) )
       {
          fmt::print( "file {} is not valid\n", postsolve_archive_file );
@@ -148,6 +167,8 @@ struct OptionsInfo
          command = Command::kSolve;
       else if( commandString == "postsolve" )
          command = Command::kPostsolve;
+      else if( commandString == "batch" )
+         command = Command::kBatch;
       else
       {
          fmt::print( "unknown command: {}\n", commandString );
@@ -162,15 +183,18 @@ struct OptionsInfo
 
       options_description desc( fmt::format( "{} command", commandString ) );
 
-      desc.add_options()( "file,f", value( &instance_file ), "instance file" );
+      if( command != Command::kBatch )
+         desc.add_options()( "file,f", value( &instance_file ),
+                             "instance file" );
 
       desc.add_options()(
           "arithmetic-type,a",
           value( &arithmetic_type )->default_value( ArithmeticType::kDouble ),
           arithmetic_type_message.c_str() );
-      desc.add_options()( "postsolve-archive,v",
-                          value( &postsolve_archive_file ),
-                          "filename for postsolve archive" );
+      if( command != Command::kBatch )
+         desc.add_options()( "postsolve-archive,v",
+                             value( &postsolve_archive_file ),
+                             "filename for postsolve archive" );
 
       if( command == Command::kPresolve )
       {
@@ -181,9 +205,10 @@ struct OptionsInfo
 
       if( command != Command::kPostsolve )
       {
-         desc.add_options()( "reduced-problem,r",
-                             value( &reduced_problem_file ),
-                             "filename for reduced problem" );
+         if( command != Command::kBatch )
+            desc.add_options()( "reduced-problem,r",
+                                value( &reduced_problem_file ),
+                                "filename for reduced problem" );
 
          desc.add_options()( "parameter-settings,p",
                              value( &param_settings_file ),
@@ -198,6 +223,33 @@ struct OptionsInfo
                              value( &nthreads )->default_value( 0 ) );
       }
 
+      if( command == Command::kPresolve || command == Command::kSolve )
+      {
+         desc.add_options()( "checkpoint", value( &checkpoint_file ),
+                             "filename for checkpoints of presolve, written "
+                             "every presolve.checkpointinterval seconds" );
+         desc.add_options()( "resume", value( &resume_file ),
+                             "checkpoint to continue presolving from instead "
+                             "of an instance file" );
+         desc.add_options()( "cache-dir", value( &cache_dir ),
+                             "directory of cached presolve results, an "
+                             "identical problem presolved with the same "
+                             "parameters is loaded from it" );
+      }
+
+      if( command == Command::kBatch )
+      {
+         desc.add_options()( "instances,i", value( &instance_list_file ),
+                             "file with one instance file per line" );
+         desc.add_options()(
+             "output-dir,d", value( &output_dir ),
+             "directory for the reduced problems and postsolve archives" );
+         desc.add_options()(
+             "instance-threads",
+             value( &ninstancethreads )->default_value( 1 ),
+             "number of threads for presolving a single instance" );
+      }
+
       if(command == Command::kPostsolve){
          desc.add_options()( "dual-reduced-solution",
                              value( &reduced_dual_solution_file ),
@@ -210,7 +262,7 @@ struct OptionsInfo
                              "filename for the basis (*bas) of the reduced problem" );
       }
 
-      if( command != Command::kPresolve )
+      if( command == Command::kSolve || command == Command::kPostsolve )
       {
          desc.add_options()( "reduced-solution,u",
                              value( &reduced_solution_file ),
@@ -274,7 +326,21 @@ struct OptionsInfo
       {
       case Command::kSolve:
       case Command::kPresolve:
-         if( instance_file.empty() )
+#ifndef PAPILO_SERIALIZATION_AVAILABLE
+         if( !checkpoint_file.empty() || !resume_file.empty() )
+         {
+            fmt::print( "checkpoints require Boost serialization package that "
+                        "is currently not provided\n" );
+            return;
+         }
+         if( !cache_dir.empty() )
+         {
+            fmt::print( "the presolve cache requires Boost serialization "
+                        "package that is currently not provided\n" );
+            return;
+         }
+#endif
+         if( instance_file.empty() && resume_file.empty() )
          {
             fmt::print( "{} requires an instance file\n", commandString );
             return;
@@ -296,6 +362,14 @@ struct OptionsInfo
             return;
          }
          break;
+      case Command::kBatch:
+         if( instance_list_file.empty() )
+         {
+            fmt::print( "{} requires a file with the instances\n",
+                        commandString );
+            return;
+         }
+         break;
       case Command::kNone:
          assert( false );
       }
@@ -324,7 +398,7 @@ parseOptions( int argc, char* argv[] )
    options_description global{};
    global.add_options()( "help,h", "produce help message" );
    global.add_options()( "command", value<std::string>(),
-                         "command: {presolve, solve, postsolve}." );
+                         "command: {presolve, solve, postsolve, batch}." );
    global.add_options()( "args", value<std::vector<std::string>>(),
                          "arguments for the command" );
 
@@ -347,6 +421,7 @@ parseOptions( int argc, char* argv[] )
       optionsInfo.parse( "presolve" );
       optionsInfo.parse( "solve" );
       optionsInfo.parse( "postsolve" );
+      optionsInfo.parse( "batch" );
       return optionsInfo;
    }
 
@@ -290,6 +290,24 @@ class ParameterSet
       }
    };
 
+   struct CopyParameterVisitor : public boost::static_visitor<>
+   {
+      template <typename OptionType>
+      void
+      operator()( OptionType& option, const OptionType& other ) const
+      {
+         *option.storage = *other.storage;
+      }
+
+      template <typename OptionType, typename OtherType>
+      void
+      operator()( OptionType&, const OtherType& ) const
+      {
+         throw std::domain_error(
+             "tried to copy value of parameter with different type" );
+      }
+   };
+
    std::map<String, Parameter, std::less<>,
             Allocator<std::pair<const String, Parameter>>>
        parameters;
@@ -405,6 +423,23 @@ class ParameterSet
       boost::apply_visitor( visitor, parameters[key].value );
    }
 
+   /// sets every parameter that also exists in the given set to the value it
+   /// has there, parameters missing in the other set keep their value
+   void
+   copyValues( const ParameterSet& other )
+   {
+      CopyParameterVisitor visitor;
+      for( auto& param : parameters )
+      {
+         auto it = other.parameters.find( param.first );
+         if( it == other.parameters.end() )
+            continue;
+
+         boost::apply_visitor( visitor, param.second.value,
+                               it->second.value );
+      }
+   }
+
    template <typename OutputIt>
    void
    printParams( OutputIt out )
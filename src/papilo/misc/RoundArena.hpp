@@ -0,0 +1,243 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_MISC_ROUND_ARENA_HPP_
+#define _PAPILO_MISC_ROUND_ARENA_HPP_
+
+#include "papilo/Config.hpp"
+#include "papilo/misc/Alloc.hpp"
+#ifdef PAPILO_TBB
+#include "papilo/misc/tbb.hpp"
+#endif
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace papilo
+{
+
+/// Memory arena for the temporary data of a presolving round. Memory is
+/// handed out by bumping a pointer inside chunks that belong to the calling
+/// thread, so that threads do not contend for the allocator. Deallocations
+/// are ignored and all memory is recycled at once by reset(), which must only
+/// be called when no container that allocated from the arena is alive.
+/// Copying an arena yields a new empty arena.
+class RoundArena
+{
+ public:
+   static constexpr std::size_t CHUNK_SIZE = std::size_t{ 1 } << 20;
+
+   RoundArena() = default;
+
+   RoundArena( const RoundArena& ) : RoundArena() {}
+
+   RoundArena&
+   operator=( const RoundArena& )
+   {
+      return *this;
+   }
+
+   ~RoundArena()
+   {
+      forEachThread( []( ThreadChunks& local ) {
+         for( Chunk& chunk : local.chunks )
+            ::operator delete( chunk.data );
+      } );
+   }
+
+   void*
+   allocate( std::size_t bytes, std::size_t alignment )
+   {
+#ifdef PAPILO_TBB
+      ThreadChunks& local = threadchunks.local();
+#else
+      ThreadChunks& local = threadchunks;
+#endif
+      while( true )
+      {
+         if( local.current < local.chunks.size() )
+         {
+            Chunk& chunk = local.chunks[local.current];
+            std::size_t offset =
+                ( local.offset + alignment - 1 ) / alignment * alignment;
+
+            if( offset + bytes <= chunk.size )
+            {
+               local.offset = offset + bytes;
+               local.used += bytes;
+               local.peak = std::max( local.peak, local.used );
+               return chunk.data + offset;
+            }
+
+            // continue in the next chunk if this one is exhausted
+            ++local.current;
+            local.offset = 0;
+            continue;
+         }
+
+         // allocations that exceed the chunk size get a chunk of their own
+         Chunk chunk;
+         chunk.size = std::max( CHUNK_SIZE, bytes + alignment );
+         chunk.data = static_cast<char*>( ::operator new( chunk.size ) );
+         local.chunks.push_back( chunk );
+         local.current = local.chunks.size() - 1;
+         local.offset = 0;
+      }
+   }
+
+   /// recycles the memory of all threads
+   void
+   reset()
+   {
+      forEachThread( []( ThreadChunks& local ) {
+         local.current = 0;
+         local.offset = 0;
+         local.used = 0;
+      } );
+   }
+
+   /// returns the maximal number of bytes that were in use at the same time,
+   /// summed over the threads
+   std::size_t
+   getPeakBytes() const
+   {
+      std::size_t peak = 0;
+      forEachThread(
+          [&peak]( const ThreadChunks& local ) { peak += local.peak; } );
+      return peak;
+   }
+
+ private:
+   struct Chunk
+   {
+      char* data;
+      std::size_t size;
+   };
+
+   struct ThreadChunks
+   {
+      std::vector<Chunk> chunks;
+      std::size_t current = 0;
+      std::size_t offset = 0;
+      std::size_t used = 0;
+      std::size_t peak = 0;
+   };
+
+   template <typename F>
+   void
+   forEachThread( F&& f )
+   {
+#ifdef PAPILO_TBB
+      for( ThreadChunks& local : threadchunks )
+         f( local );
+#else
+      f( threadchunks );
+#endif
+   }
+
+   template <typename F>
+   void
+   forEachThread( F&& f ) const
+   {
+#ifdef PAPILO_TBB
+      for( const ThreadChunks& local : threadchunks )
+         f( local );
+#else
+      f( threadchunks );
+#endif
+   }
+
+#ifdef PAPILO_TBB
+   tbb::enumerable_thread_specific<ThreadChunks> threadchunks;
+#else
+   ThreadChunks threadchunks;
+#endif
+};
+
+/// allocator that takes its memory from a RoundArena, or from the default
+/// allocator if no arena is given
+template <typename T>
+class ArenaAllocator
+{
+ public:
+   using value_type = T;
+   using propagate_on_container_move_assignment = std::true_type;
+   using propagate_on_container_swap = std::true_type;
+
+   ArenaAllocator( RoundArena* _arena = nullptr ) noexcept : arena( _arena ) {}
+
+   template <typename U>
+   ArenaAllocator( const ArenaAllocator<U>& other ) noexcept
+       : arena( other.getArena() )
+   {
+   }
+
+   T*
+   allocate( std::size_t n )
+   {
+      if( arena == nullptr )
+         return Allocator<T>().allocate( n );
+
+      return static_cast<T*>( arena->allocate( n * sizeof( T ), alignof( T ) ) );
+   }
+
+   void
+   deallocate( T* p, std::size_t n )
+   {
+      if( arena == nullptr )
+         Allocator<T>().deallocate( p, n );
+   }
+
+   RoundArena*
+   getArena() const
+   {
+      return arena;
+   }
+
+ private:
+   RoundArena* arena;
+};
+
+template <typename T, typename U>
+bool
+operator==( const ArenaAllocator<T>& a, const ArenaAllocator<U>& b )
+{
+   return a.getArena() == b.getArena();
+}
+
+template <typename T, typename U>
+bool
+operator!=( const ArenaAllocator<T>& a, const ArenaAllocator<U>& b )
+{
+   return a.getArena() != b.getArena();
+}
+
+/// vector for temporary data of a presolving round
+template <typename T>
+using ArenaVec = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace papilo
+
+#endif
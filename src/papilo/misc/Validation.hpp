@@ -90,7 +90,7 @@ struct Validation
    {
       SolParser<REAL> parser;
 
-      std::vector<int> one_to_one_mapping;
+      Vec<int> one_to_one_mapping;
       for( int i = 0; i < (int) postsolveStorage.nColsOriginal; i++ )
          one_to_one_mapping.push_back( i );
 
@@ -23,13 +23,16 @@
 #ifndef _PAPILO_MISC_WRAPPERS_HPP_
 #define _PAPILO_MISC_WRAPPERS_HPP_
 
+#include "papilo/core/BatchPresolve.hpp"
 #include "papilo/core/Presolve.hpp"
+#include "papilo/core/PresolveCache.hpp"
 #include "papilo/core/postsolve/Postsolve.hpp"
 #include "papilo/io/Parser.hpp"
 #include "papilo/io/MpsWriter.hpp"
 #include "papilo/io/OpbWriter.hpp"
 #include "papilo/io/SolParser.hpp"
 #include "papilo/io/SolWriter.hpp"
+#include "papilo/misc/Hash.hpp"
 #include "papilo/misc/NumericalStatistics.hpp"
 #include "papilo/misc/OptionsParser.hpp"
 #include "papilo/misc/Validation.hpp"
@@ -42,6 +45,7 @@
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/lexical_cast.hpp>
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <utility>
@@ -56,6 +60,84 @@ enum class ResultStatus
    kError
 };
 
+/// sets the parameters in the file, lines have the form key = value and
+/// everything after a '#' is ignored
+inline void
+read_parameter_file( ParameterSet& paramSet, const std::string& filename )
+{
+   std::ifstream input( filename );
+   if( !input )
+   {
+      fmt::print( "could not read parameter file '{}'\n", filename );
+      return;
+   }
+
+   String theoptionstr;
+   String thevaluestr;
+   for( String line; getline( input, line ); )
+   {
+      std::size_t pos = line.find_first_of( '#' );
+      if( pos != String::npos )
+         line = line.substr( 0, pos );
+
+      pos = line.find_first_of( '=' );
+
+      if( pos == String::npos )
+         continue;
+
+      theoptionstr = line.substr( 0, pos - 1 );
+      thevaluestr = line.substr( pos + 1 );
+
+      boost::algorithm::trim( theoptionstr );
+      boost::algorithm::trim( thevaluestr );
+
+      try
+      {
+         paramSet.parseParameter( theoptionstr.c_str(), thevaluestr.c_str() );
+         fmt::print( "set {} = {}\n", theoptionstr, thevaluestr );
+      }
+      catch( const std::exception& e )
+      {
+         fmt::print( "parameter '{}' could not be set: {}\n", line, e.what() );
+      }
+   }
+}
+
+/// sets the parameters given on the command line as --key=value
+inline void
+parse_parameters( ParameterSet& paramSet,
+                  const std::vector<std::string>& options )
+{
+   String theoptionstr;
+   String thevaluestr;
+
+   for( const auto& option : options )
+   {
+      std::size_t pos = option.find_first_of( '=' );
+      if( pos != String::npos && pos > 2 )
+      {
+         theoptionstr = option.substr( 2, pos - 2 );
+         thevaluestr = option.substr( pos + 1 );
+         try
+         {
+            paramSet.parseParameter( theoptionstr.c_str(),
+                                     thevaluestr.c_str() );
+            fmt::print( "set {} = {}\n", theoptionstr, thevaluestr );
+         }
+         catch( const std::exception& e )
+         {
+            fmt::print( "parameter '{}' could not be set: {}\n", option,
+                        e.what() );
+         }
+      }
+      else
+      {
+         fmt::print( "parameter '{}' could not be set: value expected\n",
+                     option );
+      }
+   }
+}
+
 template <typename REAL>
 ResultStatus
 presolve_and_solve(
@@ -69,19 +151,36 @@ presolve_and_solve(
       double readtime = 0;
       Problem<REAL> problem;
       boost::optional<Problem<REAL>> prob;
+      boost::optional<PresolveCheckpoint<REAL>> checkpoint;
 
+      if( !opts.resume_file.empty() )
       {
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
          Timer t( readtime );
-         prob = Parser<REAL>::loadProblem( opts.instance_file );
+         checkpoint = readCheckpoint<REAL>( opts.resume_file );
+#endif
+         if( !checkpoint )
+         {
+            fmt::print( "error loading checkpoint {}\n", opts.resume_file );
+            return ResultStatus::kError;
+         }
+         problem = checkpoint->postsolve.getOriginalProblem();
       }
-
-      // Check whether reading was successful or not
-      if( !prob )
+      else
       {
-         fmt::print( "error loading problem {}\n", opts.instance_file );
-         return ResultStatus::kError;
+         {
+            Timer t( readtime );
+            prob = Parser<REAL>::loadProblem( opts.instance_file );
+         }
+
+         // Check whether reading was successful or not
+         if( !prob )
+         {
+            fmt::print( "error loading problem {}\n", opts.instance_file );
+            return ResultStatus::kError;
+         }
+         problem = *prob;
       }
-      problem = *prob;
 
       fmt::print( "reading took {:.3} seconds\n", readtime );
 
@@ -104,81 +203,10 @@ presolve_and_solve(
             satSolverFactory->add_parameters(paramSet);
 
          if( !opts.param_settings_file.empty() && !opts.print_params )
-         {
-            std::ifstream input( opts.param_settings_file );
-            if( input )
-            {
-               String theoptionstr;
-               String thevaluestr;
-               for( String line; getline( input, line ); )
-               {
-                  std::size_t pos = line.find_first_of( '#' );
-                  if( pos != String::npos )
-                     line = line.substr( 0, pos );
-
-                  pos = line.find_first_of( '=' );
-
-                  if( pos == String::npos )
-                     continue;
-
-                  theoptionstr = line.substr( 0, pos - 1 );
-                  thevaluestr = line.substr( pos + 1 );
-
-                  boost::algorithm::trim( theoptionstr );
-                  boost::algorithm::trim( thevaluestr );
-
-                  try
-                  {
-                     paramSet.parseParameter( theoptionstr.c_str(),
-                                              thevaluestr.c_str() );
-                     fmt::print( "set {} = {}\n", theoptionstr, thevaluestr );
-                  }
-                  catch( const std::exception& e )
-                  {
-                     fmt::print( "parameter '{}' could not be set: {}\n", line,
-                                 e.what() );
-                  }
-               }
-            }
-            else
-            {
-               fmt::print( "could not read parameter file '{}'\n",
-                           opts.param_settings_file );
-            }
-         }
+            read_parameter_file( paramSet, opts.param_settings_file );
 
          if( !opts.unparsed_options.empty() )
-         {
-            String theoptionstr;
-            String thevaluestr;
-
-            for( const auto& option : opts.unparsed_options )
-            {
-               std::size_t pos = option.find_first_of( '=' );
-               if( pos != String::npos && pos > 2 )
-               {
-                  theoptionstr = option.substr( 2, pos - 2 );
-                  thevaluestr = option.substr( pos + 1 );
-                  try
-                  {
-                     paramSet.parseParameter( theoptionstr.c_str(),
-                                              thevaluestr.c_str() );
-                     fmt::print( "set {} = {}\n", theoptionstr, thevaluestr );
-                  }
-                  catch( const std::exception& e )
-                  {
-                     fmt::print( "parameter '{}' could not be set: {}\n",
-                                 option, e.what() );
-                  }
-               }
-               else
-               {
-                  fmt::print(
-                      "parameter '{}' could not be set: value expected\n",
-                      option );
-               }
-            }
-         }
+            parse_parameters( paramSet, opts.unparsed_options );
 
          if( opts.print_params )
          {
@@ -245,7 +273,54 @@ presolve_and_solve(
          }
       }
 
-      auto result = presolve.apply( problem, store_dual );
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
+      if( !opts.checkpoint_file.empty() )
+         presolve.setCheckpointHandler(
+             [&opts]( const PresolveCheckpoint<REAL>& state ) {
+                if( writeCheckpoint( state, opts.checkpoint_file ) )
+                   fmt::print( "checkpoint written to {} after round {}\n",
+                               opts.checkpoint_file, state.stats.nrounds );
+                else
+                   fmt::print( "could not write checkpoint to {}\n",
+                               opts.checkpoint_file );
+             } );
+#endif
+
+      // results are only cached for fresh runs, with VeriPB the reduced
+      // problem also depends on the row scaling factors
+      boost::optional<PresolveResult<REAL>> cached;
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
+      std::unique_ptr<PresolveCache<REAL>> cache;
+      PresolveCacheKey cachekey;
+      if( !opts.cache_dir.empty() && !checkpoint &&
+          !presolve.getPresolveOptions().verification_with_VeriPB )
+      {
+         cache.reset( new PresolveCache<REAL>( opts.cache_dir ) );
+         ParameterSet paramSet = presolve.getParameters();
+         cachekey = cache->computeKey( problem, paramSet, store_dual );
+         cached = cache->load( cachekey, problem );
+         if( cached )
+            fmt::print( "presolve result loaded from {}\n",
+                        cache->getFilename( cachekey ) );
+      }
+#endif
+
+      PresolveResult<REAL> result =
+          cached       ? std::move( *cached )
+          : checkpoint ? presolve.resume( problem, std::move( *checkpoint ) )
+                       : presolve.apply( problem, store_dual );
+
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
+      if( cache && !cached )
+      {
+         if( cache->store( cachekey, problem, result ) )
+            fmt::print( "presolve result stored in {}\n",
+                        cache->getFilename( cachekey ) );
+         else
+            fmt::print( "could not write presolve result to {}\n",
+                        cache->getFilename( cachekey ) );
+      }
+#endif
 
       if( !opts.optimal_solution_file.empty() )
       {
@@ -414,10 +489,226 @@ presolve_and_solve(
       fmt::print( "Memory out exception occurred! Please assign more memory\n" );
       return ResultStatus::kError;
    }
+   catch( const std::invalid_argument& ex )
+   {
+      fmt::print( "{}\n", ex.what() );
+      return ResultStatus::kError;
+   }
 
    return ResultStatus::kOk;
 }
 
+/// presolves the instances listed in a file concurrently. The reduced
+/// problem and the postsolve archive of every instance are written to the
+/// output directory if one is given.
+template <typename REAL>
+ResultStatus
+batch_presolve( const OptionsInfo& opts )
+{
+   Vec<std::string> instances;
+   {
+      std::ifstream input( opts.instance_list_file );
+      if( !input )
+      {
+         fmt::print( "could not read instance list '{}'\n",
+                     opts.instance_list_file );
+         return ResultStatus::kError;
+      }
+
+      for( String line; getline( input, line ); )
+      {
+         std::size_t pos = line.find_first_of( '#' );
+         if( pos != String::npos )
+            line = line.substr( 0, pos );
+         boost::algorithm::trim( line );
+         if( !line.empty() )
+            instances.push_back( line );
+      }
+   }
+
+   // the parameters are parsed once and copied to the Presolve instances of
+   // the threads
+   Presolve<REAL> presolve;
+   presolve.addDefaultPresolvers();
+   ParameterSet paramSet = presolve.getParameters();
+
+   if( !opts.param_settings_file.empty() && !opts.print_params )
+      read_parameter_file( paramSet, opts.param_settings_file );
+
+   if( !opts.unparsed_options.empty() )
+      parse_parameters( paramSet, opts.unparsed_options );
+
+   if( opts.print_params )
+   {
+      String paramDesc;
+      paramSet.printParams( std::back_inserter( paramDesc ) );
+      puts( paramDesc.c_str() );
+      return ResultStatus::kOk;
+   }
+
+   BatchPresolve<REAL> batch( [&paramSet]( Presolve<REAL>& instancePresolve ) {
+      instancePresolve.addDefaultPresolvers();
+      instancePresolve.getParameters().copyValues( paramSet );
+      instancePresolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   } );
+   batch.setThreads( std::max( 0, opts.nthreads ) );
+   batch.setInstanceThreads( std::max( 1, opts.ninstancethreads ) );
+
+   struct InstanceInfo
+   {
+      bool loaded = false;
+      PresolveStatus status = PresolveStatus::kUnchanged;
+      int nrows = 0;
+      int ncols = 0;
+      int64_t nnz = 0;
+      int nrowsreduced = 0;
+      int ncolsreduced = 0;
+      int64_t nnzreduced = 0;
+      double time = 0.0;
+   };
+   Vec<InstanceInfo> infos( instances.size() );
+
+   auto load = [&]( int i ) {
+      boost::optional<Problem<REAL>> prob =
+          Parser<REAL>::loadProblem( instances[i] );
+      if( prob )
+      {
+         infos[i].loaded = true;
+         infos[i].nrows = prob->getNRows();
+         infos[i].ncols = prob->getNCols();
+         infos[i].nnz = prob->getConstraintMatrix().getNnz();
+      }
+      return prob;
+   };
+
+   // the output files are named after the instance file without directory
+   // and extensions. Instances with the same name get their position in the
+   // list appended, so that no output file is overwritten.
+   Vec<std::string> outputnames( instances.size() );
+   if( !opts.output_dir.empty() )
+   {
+      HashMap<std::string, int> namecount;
+      for( std::size_t i = 0; i != instances.size(); ++i )
+      {
+         std::string name = instances[i];
+         std::size_t pos = name.find_last_of( "/\\" );
+         if( pos != std::string::npos )
+            name = name.substr( pos + 1 );
+         for( const char* ext : { ".gz", ".bz2", ".mps", ".lp", ".opb" } )
+         {
+            if( boost::algorithm::ends_with( name, ext ) )
+               name = name.substr( 0, name.size() - strlen( ext ) );
+         }
+         outputnames[i] = name;
+         ++namecount[name];
+      }
+
+      for( std::size_t i = 0; i != instances.size(); ++i )
+      {
+         if( namecount[outputnames[i]] > 1 )
+            outputnames[i] += fmt::format( "_{}", i + 1 );
+      }
+
+      // an appended position can still clash with the name of another
+      // instance
+      HashMap<std::string, std::size_t> owner;
+      for( std::size_t i = 0; i != instances.size(); ++i )
+      {
+         auto inserted = owner.emplace( outputnames[i], i );
+         if( !inserted.second )
+         {
+            fmt::print( "instances '{}' and '{}' have the same output name "
+                        "'{}'\n",
+                        instances[inserted.first->second], instances[i],
+                        outputnames[i] );
+            return ResultStatus::kError;
+         }
+         outputnames[i] = opts.output_dir + "/" + outputnames[i];
+      }
+   }
+
+   auto handle = [&]( int i, Problem<REAL>& problem,
+                      PresolveResult<REAL>& result, const Statistics& stats ) {
+      infos[i].status = result.status;
+      infos[i].nrowsreduced = problem.getNRows();
+      infos[i].ncolsreduced = problem.getNCols();
+      infos[i].nnzreduced = problem.getConstraintMatrix().getNnz();
+      infos[i].time = stats.presolvetime;
+
+      if( opts.output_dir.empty() ||
+          ( result.status != PresolveStatus::kReduced &&
+            result.status != PresolveStatus::kUnchanged ) )
+         return;
+
+      const std::string& name = outputnames[i];
+      MpsWriter<REAL>::writeProb( name + ".mps", problem,
+                                  result.postsolve.origrow_mapping,
+                                  result.postsolve.origcol_mapping );
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
+      std::ofstream ofs( name + ".postsolve", std::ios_base::binary );
+      boost::archive::binary_oarchive oa( ofs );
+      oa << result.postsolve;
+#endif
+   };
+
+   batch.apply( static_cast<int>( instances.size() ), load, handle );
+
+   auto status_name = []( PresolveStatus status ) {
+      switch( status )
+      {
+      case PresolveStatus::kUnchanged:
+         return "unchanged";
+      case PresolveStatus::kReduced:
+         return "reduced";
+      case PresolveStatus::kUnbndOrInfeas:
+         return "unbnd_or_infeas";
+      case PresolveStatus::kUnbounded:
+         return "unbounded";
+      case PresolveStatus::kInfeasible:
+         return "infeasible";
+      }
+      return "";
+   };
+
+   fmt::print( "\n{:<40} {:>15} {:>10} {:>10} {:>12} {:>10}\n", "instance",
+               "status", "rows", "columns", "nonzeros", "time" );
+   for( int i = 0; i < (int) instances.size(); ++i )
+   {
+      const InstanceInfo& info = infos[i];
+      if( !info.loaded )
+      {
+         fmt::print( "{:<40} {:>15}\n", instances[i], "read error" );
+         continue;
+      }
+      fmt::print( "{:<40} {:>15} {:>10} {:>10} {:>12} {:>10.3f}\n",
+                  instances[i], status_name( info.status ),
+                  fmt::format( "{}/{}", info.nrowsreduced, info.nrows ),
+                  fmt::format( "{}/{}", info.ncolsreduced, info.ncols ),
+                  fmt::format( "{}/{}", info.nnzreduced, info.nnz ),
+                  info.time );
+   }
+
+   const BatchStatistics& stats = batch.getStatistics();
+   fmt::print( "\nbatch presolve of {} instances finished after {:.3f} "
+               "seconds\n",
+               stats.ninstances, stats.walltime );
+   fmt::print( "  reduced:       {}\n", stats.nreduced );
+   fmt::print( "  unchanged:     {}\n", stats.nunchanged );
+   fmt::print( "  infeasible:    {}\n", stats.ninfeasible );
+   fmt::print( "  read errors:   {}\n", stats.nfailed );
+   fmt::print( "  rows:          {} -> {}\n", stats.nrowsbefore,
+               stats.nrowsafter );
+   fmt::print( "  columns:       {} -> {}\n", stats.ncolsbefore,
+               stats.ncolsafter );
+   fmt::print( "  nonzeros:      {} -> {}\n", stats.nnzbefore,
+               stats.nnzafter );
+   fmt::print( "  presolve time: {:.3f} seconds\n", stats.presolvetime );
+   fmt::print( "  throughput:    {:.2f} instances per second\n",
+               stats.getThroughput() );
+
+   return stats.nfailed == 0 ? ResultStatus::kOk : ResultStatus::kError;
+}
+
 template <typename REAL>
 void
 postsolve( PostsolveStorage<REAL>& postsolveStorage,
@@ -55,6 +55,7 @@
 #include "tbb/combinable.h"
 #include "tbb/concurrent_hash_map.h"
 #include "tbb/concurrent_vector.h"
+#include "tbb/enumerable_thread_specific.h"
 #include "tbb/parallel_for.h"
 #include "tbb/parallel_invoke.h"
 #include "tbb/partitioner.h"
@@ -57,6 +57,12 @@ class DominatedCols : public PresolveMethod<REAL>
       return false;
    }
 
+   void
+   addPresolverParams( ParameterSet& paramSet ) override
+   {
+      this->addTimeBudgetParameter( paramSet );
+   }
+
    /// stores implied bound information and signatures for a column
    struct ColInfo
    {
@@ -215,7 +221,15 @@ DominatedCols<REAL>::execute( const Problem<REAL>& problem,
        } );
 #endif
 
-   auto checkDominance = [&]( int col1, int col2, int scal1, int scal2 ) {
+   // the signatures visit every nonzero once
+   this->addWork( static_cast<double>( consMatrix.getNnz() ) );
+
+   // the columns were collected in parallel, sort them so that the columns
+   // scanned within the work budget do not depend on the number of threads
+   pdqsort( unboundedcols.begin(), unboundedcols.end() );
+
+   auto checkDominance = [&]( int col1, int col2, int scal1, int scal2,
+                              int64_t& work ) {
       assert( !cflags[col1].test( ColFlag::kIntegral ) ||
               cflags[col2].test( ColFlag::kIntegral ) );
 
@@ -233,6 +247,8 @@ DominatedCols<REAL>::execute( const Problem<REAL>& problem,
       const int* col2rows = col2vec.getIndices();
       const REAL* col2vals = col2vec.getValues();
 
+      work += col1len + col2len;
+
       int i = 0;
       int j = 0;
 
@@ -351,144 +367,147 @@ DominatedCols<REAL>::execute( const Problem<REAL>& problem,
    Vec<DomcolReduction> domcolreductions;
 #endif
 
-#ifdef PAPILO_TBB
-   // scan unbounded columns if they dominate other columns
-   tbb::parallel_for(
-       tbb::blocked_range<int>( 0, (int) unboundedcols.size() ),
-       [&]( const tbb::blocked_range<int>& r ) {
-          for( int k = r.begin(); k != r.end(); ++k )
-#else
-   for( int k = 0; k < (int) unboundedcols.size(); ++k )
-#endif
+   // scan unbounded columns if they dominate other columns, the work of a
+   // column is the scan of its shortest row and of the compared columns
+   this->for_each_within_work_budget(
+       static_cast<int>( unboundedcols.size() ), true, [&]( int k ) {
+          int64_t work = 0;
+
+          // skip the remaining columns once the budget is used up or presolve
+          // is interrupted
+          if( this->is_budget_exceeded(
+                  timer, problemUpdate.getPresolveOptions().tlim ) )
+             return work;
+
+          int unbounded_col = unboundedcols[k];
+          int lbfree = colinfo[unbounded_col].lbfree;
+          int ubfree = colinfo[unbounded_col].ubfree;
+
+          assert( lbfree != 0 || ubfree != 0 );
+
+          auto colvec = consMatrix.getColumnCoefficients( unbounded_col );
+          int collen = colvec.getLength();
+          const int* colrows = colvec.getIndices();
+          const REAL* colvals = colvec.getValues();
+          int scale;
+          int implrowlock;
+
+          // determine the scale of the dominating column depending on
+          // whether the upper or lower bound is free, and remember which
+          // row needs to be locked to protect the implied bound (if any)
+          if( ubfree != 0 )
           {
-             int unbounded_col = unboundedcols[k];
-             int lbfree = colinfo[unbounded_col].lbfree;
-             int ubfree = colinfo[unbounded_col].ubfree;
-
-             assert( lbfree != 0 || ubfree != 0 );
+             scale = 1;
+             implrowlock = ubfree > 0 ? colrows[ubfree - 1] : -1;
+          }
+          else if( lbfree != 0 )
+          {
+             scale = -1;
+             implrowlock = lbfree > 0 ? colrows[lbfree - 1] : -1;
+          }
+          else
+             return work;
 
-             auto colvec = consMatrix.getColumnCoefficients( unbounded_col );
-             int collen = colvec.getLength();
-             const int* colrows = colvec.getIndices();
-             const REAL* colvals = colvec.getValues();
-             int scale;
-             int implrowlock;
+          int bestrow = -1;
+          int bestrowsize = std::numeric_limits<int>::max();
+          work += collen;
 
-             // determine the scale of the dominating column depending on
-             // whether the upper or lower bound is free, and remember which
-             // row needs to be locked to protect the implied bound (if any)
-             if( ubfree != 0 )
-             {
-                scale = 1;
-                implrowlock = ubfree > 0 ? colrows[ubfree - 1] : -1;
-             }
-             else if( lbfree != 0 )
+          for( int j = 0; j < collen; ++j )
+          {
+             int row = colrows[j];
+             if( ( !rflags[row].test( RowFlag::kLhsInf, RowFlag::kRhsInf ) ||
+                   ( !rflags[row].test( RowFlag::kRhsInf ) &&
+                     scale * colvals[j] > 0 ) ||
+                   ( !rflags[row].test( RowFlag::kLhsInf ) &&
+                     scale * colvals[j] < 0 ) ) &&
+                 rowsize[row] < bestrowsize )
              {
-                scale = -1;
-                implrowlock = lbfree > 0 ? colrows[lbfree - 1] : -1;
+                bestrow = j;
+                bestrowsize = rowsize[row];
              }
-             else
-                continue;
+          }
 
-             int bestrow = -1;
-             int bestrowsize = std::numeric_limits<int>::max();
+          if( bestrow == -1 || bestrowsize <= 1 )
+             return work;
 
-             for( int j = 0; j < collen; ++j )
-             {
-                int row = colrows[j];
-                if( ( !rflags[row].test( RowFlag::kLhsInf, RowFlag::kRhsInf ) ||
-                      ( !rflags[row].test( RowFlag::kRhsInf ) &&
-                        scale * colvals[j] > 0 ) ||
-                      ( !rflags[row].test( RowFlag::kLhsInf ) &&
-                        scale * colvals[j] < 0 ) ) &&
-                    rowsize[row] < bestrowsize )
-                {
-                   bestrow = j;
-                   bestrowsize = rowsize[row];
-                }
-             }
+          auto candrowvec =
+              consMatrix.getRowCoefficients( colrows[bestrow] );
+          REAL scaled_val = colvals[bestrow] * scale;
+          REAL scaled_obj = obj[unbounded_col] * scale;
+          bestrow = colrows[bestrow];
+          int rowlen = candrowvec.getLength();
+          const int* rowcols = candrowvec.getIndices();
+          const REAL* rowvals = candrowvec.getValues();
+          work += rowlen;
 
-             if( bestrow == -1 || bestrowsize <= 1 )
+          for( int j = 0; j != rowlen; ++j )
+          {
+             int col = rowcols[j];
+             if( col == unbounded_col || ( cflags[unbounded_col].test( ColFlag::kIntegral ) &&
+                               !cflags[col].test( ColFlag::kIntegral ) ) )
                 continue;
 
-             auto candrowvec =
-                 consMatrix.getRowCoefficients( colrows[bestrow] );
-             REAL scaled_val = colvals[bestrow] * scale;
-             REAL scaled_obj = obj[unbounded_col] * scale;
-             bestrow = colrows[bestrow];
-             int rowlen = candrowvec.getLength();
-             const int* rowcols = candrowvec.getIndices();
-             const REAL* rowvals = candrowvec.getValues();
+             bool to_lb = false;
+             bool to_ub = false;
 
-             for( int j = 0; j != rowlen; ++j )
+             if( !rflags[bestrow].test( RowFlag::kLhsInf,
+                                        RowFlag::kRhsInf ) )
              {
-                int col = rowcols[j];
-                if( col == unbounded_col || ( cflags[unbounded_col].test( ColFlag::kIntegral ) &&
-                                  !cflags[col].test( ColFlag::kIntegral ) ) )
-                   continue;
-
-                bool to_lb = false;
-                bool to_ub = false;
-
-                if( !rflags[bestrow].test( RowFlag::kLhsInf,
-                                           RowFlag::kRhsInf ) )
-                {
-                   if( !cflags[col].test( ColFlag::kLbInf ) &&
-                       num.isEq( scaled_val, rowvals[j] ) &&
-                       num.isLE( scaled_obj, obj[col] ) &&
-                       checkDominance( unbounded_col, col, scale, 1 ) )
-                      to_lb = true;
-
-                   if( !cflags[col].test( ColFlag::kUbInf ) &&
-                       num.isEq( scaled_val, -rowvals[j] ) &&
-                       num.isLE( scaled_obj, -obj[col] ) &&
-                       checkDominance( unbounded_col, col, scale, -1 ) )
-                      to_ub = true;
-                }
-                else if( rflags[bestrow].test( RowFlag::kLhsInf ) )
-                {
-                   assert( scaled_val > 0 &&
-                           !rflags[bestrow].test( RowFlag::kRhsInf ) );
-                   if( !cflags[col].test( ColFlag::kLbInf ) &&
-                       num.isLE( scaled_val, rowvals[j] ) &&
-                       num.isLE( scaled_obj, obj[col] ) &&
-                       checkDominance( unbounded_col, col, scale, 1 ) )
-                      to_lb = true;
-
-                   if( !cflags[col].test( ColFlag::kUbInf ) &&
-                       num.isLE( scaled_val, -rowvals[j] ) &&
-                       num.isLE( scaled_obj, -obj[col] ) &&
-                       checkDominance( unbounded_col, col, scale, -1 ) )
-                      to_ub = true;
-                }
-                else
-                {
-                   assert( scaled_val < 0 &&
-                           rflags[bestrow].test( RowFlag::kRhsInf ) );
-                   if( !cflags[col].test( ColFlag::kLbInf ) &&
-                       num.isGE( scaled_val, rowvals[j] ) &&
-                       num.isLE( scaled_obj, obj[col] ) &&
-                       checkDominance( unbounded_col, col, scale, 1 ) )
-                      to_lb = true;
-
-                   if( !cflags[col].test( ColFlag::kUbInf ) &&
-                       num.isGE( scaled_val, -rowvals[j] ) &&
-                       num.isLE( scaled_obj, -obj[col] ) &&
-                       checkDominance( unbounded_col, col, scale, -1 ) )
-                      to_ub = true;
-                }
+                if( !cflags[col].test( ColFlag::kLbInf ) &&
+                    num.isEq( scaled_val, rowvals[j] ) &&
+                    num.isLE( scaled_obj, obj[col] ) &&
+                    checkDominance( unbounded_col, col, scale, 1, work ) )
+                   to_lb = true;
+
+                if( !cflags[col].test( ColFlag::kUbInf ) &&
+                    num.isEq( scaled_val, -rowvals[j] ) &&
+                    num.isLE( scaled_obj, -obj[col] ) &&
+                    checkDominance( unbounded_col, col, scale, -1, work ) )
+                   to_ub = true;
+             }
+             else if( rflags[bestrow].test( RowFlag::kLhsInf ) )
+             {
+                assert( scaled_val > 0 &&
+                        !rflags[bestrow].test( RowFlag::kRhsInf ) );
+                if( !cflags[col].test( ColFlag::kLbInf ) &&
+                    num.isLE( scaled_val, rowvals[j] ) &&
+                    num.isLE( scaled_obj, obj[col] ) &&
+                    checkDominance( unbounded_col, col, scale, 1, work ) )
+                   to_lb = true;
+
+                if( !cflags[col].test( ColFlag::kUbInf ) &&
+                    num.isLE( scaled_val, -rowvals[j] ) &&
+                    num.isLE( scaled_obj, -obj[col] ) &&
+                    checkDominance( unbounded_col, col, scale, -1, work ) )
+                   to_ub = true;
+             }
+             else
+             {
+                assert( scaled_val < 0 &&
+                        rflags[bestrow].test( RowFlag::kRhsInf ) );
+                if( !cflags[col].test( ColFlag::kLbInf ) &&
+                    num.isGE( scaled_val, rowvals[j] ) &&
+                    num.isLE( scaled_obj, obj[col] ) &&
+                    checkDominance( unbounded_col, col, scale, 1, work ) )
+                   to_lb = true;
+
+                if( !cflags[col].test( ColFlag::kUbInf ) &&
+                    num.isGE( scaled_val, -rowvals[j] ) &&
+                    num.isLE( scaled_obj, -obj[col] ) &&
+                    checkDominance( unbounded_col, col, scale, -1, work ) )
+                   to_ub = true;
+             }
 
-                if( to_lb || to_ub )
-                {
-                   domcolreductions.push_back( DomcolReduction{
-                       unbounded_col, col, implrowlock,
-                       to_lb ? BoundChange::kUpper : BoundChange::kLower } );
-                }
+             if( to_lb || to_ub )
+             {
+                domcolreductions.push_back( DomcolReduction{
+                    unbounded_col, col, implrowlock,
+                    to_lb ? BoundChange::kUpper : BoundChange::kLower } );
              }
           }
-#ifdef PAPILO_TBB
+
+          return work;
        } );
-#endif
 
    if( !domcolreductions.empty() )
    {
@@ -125,6 +125,7 @@ DualInfer<REAL>::execute( const Problem<REAL>& problem,
       const int len = colvec.getLength();
       const int* inds = colvec.getIndices();
       const REAL* vals = colvec.getValues();
+      this->addWork( len );
 
       int i = 0;
       while(
@@ -231,9 +232,12 @@ DualInfer<REAL>::execute( const Problem<REAL>& problem,
       int c = pair.second;
       assert( colsize[c] > 0 );
 
-      bool lbinf;
-      bool ubinf;
-      checkNonImpliedBounds( c, lbinf, ubinf );
+      // once the work budget is used up the bounds of the remaining columns
+      // are treated as not implied, which relaxes their dual constraints
+      bool lbinf = false;
+      bool ubinf = false;
+      if( !this->is_work_exceeded() )
+         checkNonImpliedBounds( c, lbinf, ubinf );
 
       if( !lbinf && !ubinf )
       {
@@ -401,6 +405,7 @@ DualInfer<REAL>::execute( const Problem<REAL>& problem,
       const REAL* vals = rowvec.getValues();
       const int* inds = rowvec.getIndices();
       const int len = rowvec.getLength();
+      this->addWork( len );
 
       for( int i = 0; i != len; ++i )
       {
@@ -440,8 +445,10 @@ DualInfer<REAL>::execute( const Problem<REAL>& problem,
       }
    };
 
+   // the dual bounds found so far are valid, so the propagation can stop
+   // once the work budget is used up
    using std::swap;
-   while( !changedActivity.empty() )
+   while( !changedActivity.empty() && !this->is_work_exceeded() )
    {
       Message::debug( this, "dual progation round {} on {} dual rows\n",
                       nrounds, changedActivity.size() );
@@ -450,7 +457,11 @@ DualInfer<REAL>::execute( const Problem<REAL>& problem,
          if( dualRowFlags[dualRow].test( RowFlag::kRedundant ) )
             continue;
 
+         if( this->is_work_exceeded() )
+            break;
+
          auto colvec = consMatrix.getColumnCoefficients( dualRow );
+         this->addWork( colvec.getLength() );
 
          propagate_row( num, dualRow, colvec.getValues(), colvec.getIndices(),
                         colvec.getLength(), dualActivities[dualRow],
@@ -70,6 +70,19 @@ class Substitution : public PresolveMethod<REAL>
       return true;
    }
 
+   void
+   getCheckpointData( Vec<int>& data ) const override
+   {
+      data = ntried;
+   }
+
+   void
+   setCheckpointData( const Vec<int>& data ) override
+   {
+      assert( data.size() == ntried.size() );
+      ntried = data;
+   }
+
    PresolveStatus
    execute( const Problem<REAL>& problem,
             const ProblemUpdate<REAL>& problemUpdate,
@@ -147,8 +160,14 @@ Substitution<REAL>::execute( const Problem<REAL>& problem,
 
    for( auto equality : equalities )
    {
+      // the substitutions found so far are kept once the work budget is used
+      // up
+      if( this->is_work_exceeded() )
+         break;
+
       int row = std::get<1>( equality );
       const int length = std::get<0>( equality ).getLength();
+      this->addWork( length );
       const int* rowindices = std::get<0>( equality ).getIndices();
       const REAL* rowvalues = std::get<0>( equality ).getValues();
       REAL maxabsvalue = std::get<0>( equality ).getMaxAbsValue();
@@ -305,6 +324,8 @@ Substitution<REAL>::execute( const Problem<REAL>& problem,
                      lbrowlock = colrow;
                }
             }
+
+            this->addWork( j );
          };
 
          checkIfImpliedFree( false );
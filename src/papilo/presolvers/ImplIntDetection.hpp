@@ -57,8 +57,8 @@ class ImplIntDetection : public PresolveMethod<REAL>
        Reductions<REAL>& reductions, const Vec<ColFlags>& cflags,
        const ConstraintMatrix<REAL>& consmatrix, const Vec<REAL>& lhs_values,
        const Vec<REAL>& rhs_values, const Vec<REAL>& lower_bounds,
-       const Vec<REAL>& upper_bounds, const Vec<RowFlags>& rflags,
-       int col ) const;
+       const Vec<REAL>& upper_bounds, const Vec<RowFlags>& rflags, int col,
+       int64_t& work ) const;
 };
 
 #ifdef PAPILO_USE_EXTERN_TEMPLATES
@@ -90,35 +90,35 @@ ImplIntDetection<REAL>::execute( const Problem<REAL>& problem,
    assert( problemUpdate.getPresolveOptions().runs_sequential() );
 #endif
 
+   // the columns are checked in chunks such that the columns checked within
+   // the work budget are the same in the sequential and the parallel mode
    if( problemUpdate.getPresolveOptions().runs_sequential() ||
       !problemUpdate.getPresolveOptions().implied_integer_parallel )
    {
-      for( int col = 0; col < ncols; ++col )
-      {
+      this->for_each_within_work_budget( ncols, false, [&]( int col ) {
+         int64_t work = 0;
          if( perform_implied_integer_task(
                  problemUpdate, num, reductions, cflags, consmatrix, lhs_values,
-                 rhs_values, lower_bounds, upper_bounds, rflags,
-                 col ) == PresolveStatus::kReduced )
+                 rhs_values, lower_bounds, upper_bounds, rflags, col,
+                 work ) == PresolveStatus::kReduced )
             result = PresolveStatus::kReduced;
-      }
+         return work;
+      } );
    }
 #ifdef PAPILO_TBB
    else
    {
       Vec<Reductions<REAL>> stored_reductions( ncols );
-      tbb::parallel_for( tbb::blocked_range<int>( 0, ncols ),
-                         [&]( const tbb::blocked_range<int>& r ) {
-                            for( int col = r.begin(); col < r.end(); ++col )
-                            {
-                               if( perform_implied_integer_task(
-                                       problemUpdate, num,
-                                       stored_reductions[col], cflags,
-                                       consmatrix, lhs_values, rhs_values,
-                                       lower_bounds, upper_bounds, rflags,
-                                       col ) == PresolveStatus::kReduced )
-                                  result = PresolveStatus::kReduced;
-                            }
-                         } );
+      this->for_each_within_work_budget( ncols, true, [&]( int col ) {
+         int64_t work = 0;
+         if( perform_implied_integer_task(
+                 problemUpdate, num, stored_reductions[col], cflags,
+                 consmatrix, lhs_values, rhs_values, lower_bounds,
+                 upper_bounds, rflags, col,
+                 work ) == PresolveStatus::kReduced )
+            result = PresolveStatus::kReduced;
+         return work;
+      } );
 
       if( result == PresolveStatus::kUnchanged )
          return PresolveStatus::kUnchanged;
@@ -147,7 +147,8 @@ ImplIntDetection<REAL>::perform_implied_integer_task(
     Reductions<REAL>& reductions, const Vec<ColFlags>& cflags,
     const ConstraintMatrix<REAL>& consmatrix, const Vec<REAL>& lhs_values,
     const Vec<REAL>& rhs_values, const Vec<REAL>& lower_bounds,
-    const Vec<REAL>& upper_bounds, const Vec<RowFlags>& rflags, int col ) const
+    const Vec<REAL>& upper_bounds, const Vec<RowFlags>& rflags, int col,
+    int64_t& work ) const
 {
    PresolveStatus result = PresolveStatus::kUnchanged;
    if( cflags[col].test( ColFlag::kIntegral, ColFlag::kImplInt,
@@ -161,6 +162,7 @@ ImplIntDetection<REAL>::perform_implied_integer_task(
    int collen = colvec.getLength();
    const int* colrows = colvec.getIndices();
    const REAL* colvals = colvec.getValues();
+   work += collen;
 
    for( int i = 0; i != collen; ++i )
    {
@@ -179,6 +181,7 @@ ImplIntDetection<REAL>::perform_implied_integer_task(
       int rowlen = rowvec.getLength();
       const int* rowcols = rowvec.getIndices();
       const REAL* rowvals = rowvec.getValues();
+      work += rowlen;
 
       impliedint = true;
 
@@ -248,6 +251,7 @@ ImplIntDetection<REAL>::perform_implied_integer_task(
       int rowlen = rowvec.getLength();
       const int* rowcols = rowvec.getIndices();
       const REAL* rowvals = rowvec.getValues();
+      work += rowlen;
 
       for( int j = 0; j != rowlen; ++j )
       {
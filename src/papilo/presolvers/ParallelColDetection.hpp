@@ -27,6 +27,7 @@
 #include "papilo/core/Problem.hpp"
 #include "papilo/core/ProblemUpdate.hpp"
 #include "papilo/misc/Hash.hpp"
+#include "papilo/misc/compress_vector.hpp"
 #ifdef PAPILO_TBB
 #include "papilo/misc/tbb.hpp"
 #endif
@@ -72,25 +73,43 @@ class ParallelColDetection : public PresolveMethod<REAL>
       }
    };
 
+   /// looks up the support hash of a column computed in computeSupportHashes
    struct SupportHash
    {
+      const std::size_t* supporthashes;
+
       std::size_t
-      operator()( const std::pair<int, const int*>& row ) const
+      operator()( int col ) const
       {
-         return SupportHashCompare::hash( row );
+         return supporthashes[col];
       }
    };
 
    struct SupportEqual
    {
+      const ConstraintMatrix<REAL>* constMatrix;
+
       bool
-      operator()( const std::pair<int, const int*>& row1,
-                  const std::pair<int, const int*>& row2 ) const
+      operator()( int col1, int col2 ) const
       {
-         return SupportHashCompare::equal( row1, row2 );
+         auto colvec1 = constMatrix->getColumnCoefficients( col1 );
+         auto colvec2 = constMatrix->getColumnCoefficients( col2 );
+
+         return SupportHashCompare::equal(
+             std::make_pair( colvec1.getLength(), colvec1.getIndices() ),
+             std::make_pair( colvec2.getLength(), colvec2.getIndices() ) );
       }
    };
 
+   // hashes of the previous call, only the columns that were modified since
+   // then are hashed again
+   Vec<unsigned int> coefhashes;
+   Vec<std::size_t> supporthashes;
+   int hashround = -1;
+   // the support hashes depend on the row indices that change if rows are
+   // removed in compress()
+   bool supportsvalid = false;
+
    void
    findParallelCols( const Num<REAL>& num, const int* bucket, int bucketSize,
                      const ConstraintMatrix<REAL>& constMatrix,
@@ -100,11 +119,16 @@ class ParallelColDetection : public PresolveMethod<REAL>
 
    void
    computeColHashes( const ConstraintMatrix<REAL>& constMatrix,
-                     const Vec<REAL>& obj, unsigned int* columnHashes );
+                     const Vec<REAL>& obj, const Vec<int>& cols,
+                     unsigned int* columnHashes );
+
+   void
+   computeSupportHashes( const ConstraintMatrix<REAL>& constMatrix,
+                         const Vec<int>& cols, std::size_t* columnHashes );
 
    void
    computeSupportId( const ConstraintMatrix<REAL>& constMatrix,
-                     unsigned int* supportHashes );
+                     const int* cols, int ncols, unsigned int* supportid );
 
    void
    addPresolverParams( ParameterSet& paramSet ) override
@@ -122,14 +146,45 @@ class ParallelColDetection : public PresolveMethod<REAL>
       this->setTiming( PresolverTiming::kMedium );
    }
 
+   void
+   compress( const Vec<int>& rowmap, const Vec<int>& colmap ) override
+   {
+      if( coefhashes.size() != colmap.size() )
+      {
+         hashround = -1;
+         return;
+      }
+
+      compress_vector( colmap, coefhashes );
+      compress_vector( colmap, supporthashes );
+
+      for( int row = 0; row != (int) rowmap.size(); ++row )
+      {
+         if( rowmap[row] != row )
+         {
+            supportsvalid = false;
+            break;
+         }
+      }
+   }
+
    bool
    initialize( const Problem<REAL>& problem,
                const PresolveOptions& presolveOptions ) override
    {
+      coefhashes.clear();
+      supporthashes.clear();
+      hashround = -1;
+      supportsvalid = false;
+
       if( presolveOptions.dualreds < 2 ||
           problem.test_problem_type( ProblemFlag::kBinary ) )
+      {
          this->setEnabled( false );
-      return false;
+         return false;
+      }
+
+      return true;
    }
 
    PresolveStatus
@@ -149,7 +204,7 @@ class ParallelColDetection : public PresolveMethod<REAL>
    int
    determineBucketSize( int nColumns,
                         std::unique_ptr<unsigned int[]>& supportid,
-                        std::unique_ptr<unsigned int[]>& coefficentHashes,
+                        const unsigned int* coefficentHashes,
                         std::unique_ptr<int[]>& column, int i );
 
    bool
@@ -456,17 +511,19 @@ template <typename REAL>
 void
 ParallelColDetection<REAL>::computeColHashes(
     const ConstraintMatrix<REAL>& constMatrix, const Vec<REAL>& obj,
-    unsigned int* columnHashes )
+    const Vec<int>& cols, unsigned int* columnHashes )
 {
 #ifdef PAPILO_TBB
    tbb::parallel_for(
-       tbb::blocked_range<int>( 0, constMatrix.getNCols() ),
+       tbb::blocked_range<int>( 0, (int) cols.size() ),
        [&]( const tbb::blocked_range<int>& r ) {
-          for( int i = r.begin(); i < r.end(); ++i )
+          for( int k = r.begin(); k < r.end(); ++k )
 #else
-   for( int i = 0; i< constMatrix.getNCols(); i++)
+   for( int k = 0; k < (int) cols.size(); k++ )
 #endif
           {
+             const int i = cols[k];
+
              // compute hash-value for coefficients
              auto columnCoefficients = constMatrix.getColumnCoefficients( i );
              const REAL* values = columnCoefficients.getValues();
@@ -501,30 +558,51 @@ ParallelColDetection<REAL>::computeColHashes(
 #endif
 }
 
+template <typename REAL>
+void
+ParallelColDetection<REAL>::computeSupportHashes(
+    const ConstraintMatrix<REAL>& constMatrix, const Vec<int>& cols,
+    std::size_t* columnHashes )
+{
+#ifdef PAPILO_TBB
+   tbb::parallel_for(
+       tbb::blocked_range<int>( 0, (int) cols.size() ),
+       [&]( const tbb::blocked_range<int>& r ) {
+          for( int k = r.begin(); k < r.end(); ++k )
+#else
+   for( int k = 0; k < (int) cols.size(); k++ )
+#endif
+          {
+             auto col = constMatrix.getColumnCoefficients( cols[k] );
+             columnHashes[cols[k]] = SupportHashCompare::hash(
+                 std::make_pair( col.getLength(), col.getIndices() ) );
+          }
+#ifdef PAPILO_TBB
+       } );
+#endif
+}
+
 template <typename REAL>
 void
 ParallelColDetection<REAL>::computeSupportId(
-    const ConstraintMatrix<REAL>& constMatrix, unsigned int* supportHashes )
+    const ConstraintMatrix<REAL>& constMatrix, const int* cols, int ncols,
+    unsigned int* supportid )
 {
-   using SupportMap =
-       HashMap<std::pair<int, const int*>, int, SupportHash, SupportEqual>;
+   using SupportMap = HashMap<int, int, SupportHash, SupportEqual>;
 
-   SupportMap supportMap(
-       static_cast<std::size_t>( constMatrix.getNCols() * 1.1 ) );
+   SupportMap supportMap( static_cast<std::size_t>( ncols * 1.1 ),
+                          SupportHash{ supporthashes.data() },
+                          SupportEqual{ &constMatrix } );
 
-   for( int i = 0; i < constMatrix.getNCols(); ++i )
+   for( int k = 0; k < ncols; ++k )
    {
-      auto col = constMatrix.getColumnCoefficients( i );
-      int length = col.getLength();
-      const int* support = col.getIndices();
-
-      auto insResult =
-          supportMap.emplace( std::make_pair( length, support ), i );
+      const int i = cols[k];
+      auto insResult = supportMap.emplace( i, i );
 
       if( insResult.second )
-         supportHashes[i] = i;
+         supportid[i] = i;
       else // support already exists, use the previous support id
-         supportHashes[i] = insResult.first->second;
+         supportid[i] = insResult.first->second;
    }
 }
 
@@ -550,79 +628,167 @@ ParallelColDetection<REAL>::execute( const Problem<REAL>& problem,
    assert( ncols > 0 );
 
    std::unique_ptr<unsigned int[]> supportid{ new unsigned int[ncols] };
-   std::unique_ptr<unsigned int[]> coefhash{ new unsigned int[ncols] };
    std::unique_ptr<int[]> col{ new int[ncols] };
 
+   if( (int) coefhashes.size() != ncols )
+   {
+      coefhashes.resize( ncols );
+      supporthashes.resize( ncols );
+      hashround = -1;
+   }
+
+   // only rehash the columns that were modified since the previous call
+   const Vec<int>& modifiedround = problemUpdate.getColModifiedRounds();
+   Vec<int> coefcols;
+   Vec<int> supportcols;
+   for( int i = 0; i < ncols; ++i )
+   {
+      bool modified = hashround == -1 || modifiedround[i] >= hashround;
+      if( modified )
+         coefcols.push_back( i );
+      if( modified || !supportsvalid )
+         supportcols.push_back( i );
+   }
+
+   // parallel columns have the same support and hence lie in the same block
+   // of a bordered block diagonal structure, so the blocks are searched
+   // independently
+   const BlockStructure& blocks = problemUpdate.getBlockStructure();
+   Vec<int> blockstart;
+   Vec<int> blockcols;
+   if( blocks.hasBlocks() )
+      blocks.getColPartition( blockcols, blockstart );
+   else
+      blockstart = { 0, ncols };
+   const int nblocks = (int) blockstart.size() - 1;
+
+   auto for_each_block = [nblocks]( const auto& f ) {
+#ifdef PAPILO_TBB
+      if( nblocks > 1 )
+      {
+         tbb::parallel_for( tbb::blocked_range<int>( 0, nblocks ),
+                            [&]( const tbb::blocked_range<int>& r ) {
+                               for( int b = r.begin(); b != r.end(); ++b )
+                                  f( b );
+                            } );
+         return;
+      }
+#endif
+      for( int b = 0; b < nblocks; ++b )
+         f( b );
+   };
+
+   auto compute_support_ids = [&]() {
+      for_each_block( [&]( int b ) {
+         computeSupportId( constMatrix, col.get() + blockstart[b],
+                           blockstart[b + 1] - blockstart[b],
+                           supportid.get() );
+      } );
+   };
+
 #ifdef PAPILO_TBB
    tbb::parallel_invoke(
-       [ncols, &col]() {
+       [ncols, &col, &blockcols]() {
           for( int i = 0; i < ncols; ++i )
-             col[i] = i;
+             col[i] = blockcols.empty() ? i : blockcols[i];
        },
-       [&constMatrix, &coefhash, &obj, this]() {
-          computeColHashes( constMatrix, obj, coefhash.get() );
+       [&constMatrix, &coefcols, &obj, this]() {
+          computeColHashes( constMatrix, obj, coefcols, coefhashes.data() );
        },
-       [&constMatrix, &supportid, this]() {
-          computeSupportId( constMatrix, supportid.get() );
+       [&constMatrix, &supportcols, this]() {
+          computeSupportHashes( constMatrix, supportcols,
+                                supporthashes.data() );
        } );
+   compute_support_ids();
 #else
    for( int i = 0; i < ncols; ++i )
-      col[i] = i;
-   computeColHashes( constMatrix, obj, coefhash.get() );
-   computeSupportId( constMatrix, supportid.get() );
+      col[i] = blockcols.empty() ? i : blockcols[i];
+   computeColHashes( constMatrix, obj, coefcols, coefhashes.data() );
+   computeSupportHashes( constMatrix, supportcols, supporthashes.data() );
+   compute_support_ids();
 #endif
 
-   pdqsort(
-       col.get(), col.get() + ncols,
-       [&]( int a, int b )
-       {
-          if( cflags[a].test( ColFlag::kInactive ) && cflags[b].test( ColFlag::kInactive ) )
-             return a < b;
-          if( cflags[a].test( ColFlag::kInactive ) )
-             return true;
-          if( cflags[b].test( ColFlag::kInactive ) )
-             return false;
-          assert(constMatrix.getColumnCoefficients( a ).getLength() > 0);
-          assert(constMatrix.getColumnCoefficients( b ).getLength() > 0);
-
-          if( supportid[a] < supportid[b] ||
-              ( supportid[a] == supportid[b] && coefhash[a] < coefhash[b] ) )
-             return true;
-          else if( !( supportid[a] == supportid[b] &&
-                        coefhash[a] == coefhash[b] ) )
-             return false;
-          assert( supportid[a] == supportid[b] && coefhash[a] == coefhash[b] );
-
-          bool flag_a_integer = cflags[a].test( ColFlag::kIntegral );
-          bool flag_b_integer = cflags[b].test( ColFlag::kIntegral );
-          if( flag_a_integer != flag_b_integer )
-             return !flag_a_integer;
-
-          return // sort by scale factor
-              abs( obj[a] ) < abs( obj[b] ) ||
-              // sort by scale factor if obj is zero
-              ( abs( obj[a] ) == abs( obj[b] ) && obj[a] == 0 &&
-                determineOderingForZeroObj(
-                    constMatrix.getColumnCoefficients( a ).getValues()[0],
-                    constMatrix.getColumnCoefficients( b ).getValues()[0],
-                    colperm[a], colperm[b] ) ) ||
-              // sort by permutation
-              ( abs( obj[a] ) == abs( obj[b] ) && obj[a] != 0 &&
-                colperm[a] < colperm[b] );
-       } );
+   hashround = problemUpdate.getRound();
+   supportsvalid = true;
+
+   const unsigned int* coefhash = coefhashes.data();
+
+   auto sort_block = [&]( int begin, int end ) {
+      pdqsort(
+          col.get() + begin, col.get() + end,
+          [&]( int a, int b )
+          {
+             if( cflags[a].test( ColFlag::kInactive ) && cflags[b].test( ColFlag::kInactive ) )
+                return a < b;
+             if( cflags[a].test( ColFlag::kInactive ) )
+                return true;
+             if( cflags[b].test( ColFlag::kInactive ) )
+                return false;
+             assert(constMatrix.getColumnCoefficients( a ).getLength() > 0);
+             assert(constMatrix.getColumnCoefficients( b ).getLength() > 0);
+
+             if( supportid[a] < supportid[b] ||
+                 ( supportid[a] == supportid[b] && coefhash[a] < coefhash[b] ) )
+                return true;
+             else if( !( supportid[a] == supportid[b] &&
+                           coefhash[a] == coefhash[b] ) )
+                return false;
+             assert( supportid[a] == supportid[b] && coefhash[a] == coefhash[b] );
+
+             bool flag_a_integer = cflags[a].test( ColFlag::kIntegral );
+             bool flag_b_integer = cflags[b].test( ColFlag::kIntegral );
+             if( flag_a_integer != flag_b_integer )
+                return !flag_a_integer;
+
+             return // sort by scale factor
+                 abs( obj[a] ) < abs( obj[b] ) ||
+                 // sort by scale factor if obj is zero
+                 ( abs( obj[a] ) == abs( obj[b] ) && obj[a] == 0 &&
+                   determineOderingForZeroObj(
+                       constMatrix.getColumnCoefficients( a ).getValues()[0],
+                       constMatrix.getColumnCoefficients( b ).getValues()[0],
+                       colperm[a], colperm[b] ) ) ||
+                 // sort by permutation
+                 ( abs( obj[a] ) == abs( obj[b] ) && obj[a] != 0 &&
+                   colperm[a] < colperm[b] );
+          } );
+   };
 
    const bool is_binary = problem.test_problem_type( ProblemFlag::kBinary );
-   for( int i = 0; i < ncols; )
+   auto find_in_block = [&]( int b, Reductions<REAL>& blockreductions ) {
+      const int begin = blockstart[b];
+      const int end = blockstart[b + 1];
+
+      sort_block( begin, end );
+
+      for( int i = begin; i < end; )
+      {
+         int bucketSize =
+             determineBucketSize( end, supportid, coefhash, col, i );
+
+         // if more than one col is in the bucket find parallel cols
+         if( bucketSize > 1 )
+            findParallelCols( num, col.get() + i, bucketSize, constMatrix, obj,
+                              problem.getVariableDomains(), symmetries,
+                              is_binary, blockreductions );
+         i = i + bucketSize;
+      }
+   };
+
+   if( nblocks == 1 )
+      find_in_block( 0, reductions );
+   else
    {
-      int bucketSize =
-          determineBucketSize( ncols, supportid, coefhash, col, i );
-
-      // if more than one col is in the bucket find parallel cols
-      if( bucketSize > 1 )
-         findParallelCols( num, col.get() + i, bucketSize, constMatrix, obj,
-                           problem.getVariableDomains(), symmetries, is_binary, reductions );
-      i = i + bucketSize;
+      // the reductions of each block are collected separately and appended in
+      // the order of the blocks to stay deterministic
+      Vec<Reductions<REAL>> block_reductions( nblocks );
+      for_each_block(
+          [&]( int b ) { find_in_block( b, block_reductions[b] ); } );
+
+      for( const Reductions<REAL>& blockreductions : block_reductions )
+         reductions.append( blockreductions );
    }
+
    if( reductions.getTransactions().size() > 0 )
       result = PresolveStatus::kReduced;
    return result;
@@ -652,7 +818,7 @@ template <typename REAL>
 int
 ParallelColDetection<REAL>::determineBucketSize(
     int nColumns, std::unique_ptr<unsigned int[]>& supportid,
-    std::unique_ptr<unsigned int[]>& coefficentHashes,
+    const unsigned int* coefficentHashes,
     std::unique_ptr<int[]>& column, int i )
 {
    int j;
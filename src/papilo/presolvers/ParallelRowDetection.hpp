@@ -27,6 +27,7 @@
 #include "papilo/core/Problem.hpp"
 #include "papilo/core/ProblemUpdate.hpp"
 #include "papilo/misc/Hash.hpp"
+#include "papilo/misc/compress_vector.hpp"
 #ifdef PAPILO_TBB
 #include "papilo/misc/tbb.hpp"
 #endif
@@ -73,25 +74,43 @@ class ParallelRowDetection : public PresolveMethod<REAL>
       }
    };
 
+   /// looks up the support hash of a row computed in computeSupportHashes
    struct SupportHash
    {
+      const std::size_t* supporthashes;
+
       std::size_t
-      operator()( const std::pair<int, const int*>& row ) const
+      operator()( int row ) const
       {
-         return SupportHashCompare::hash( row );
+         return supporthashes[row];
       }
    };
 
    struct SupportEqual
    {
+      const ConstraintMatrix<REAL>* constMatrix;
+
       bool
-      operator()( const std::pair<int, const int*>& row1,
-                  const std::pair<int, const int*>& row2 ) const
+      operator()( int row1, int row2 ) const
       {
-         return SupportHashCompare::equal( row1, row2 );
+         auto rowvec1 = constMatrix->getRowCoefficients( row1 );
+         auto rowvec2 = constMatrix->getRowCoefficients( row2 );
+
+         return SupportHashCompare::equal(
+             std::make_pair( rowvec1.getLength(), rowvec1.getIndices() ),
+             std::make_pair( rowvec2.getLength(), rowvec2.getIndices() ) );
       }
    };
 
+   // hashes of the previous call, only the rows that were modified since
+   // then are hashed again
+   Vec<unsigned int> coefhashes;
+   Vec<std::size_t> supporthashes;
+   int hashround = -1;
+   // the support hashes depend on the column indices that change if columns
+   // are removed in compress()
+   bool supportsvalid = false;
+
    void
    findParallelRows( const Num<REAL>& num, const int* bucket, int bucketsize,
                      const ConstraintMatrix<REAL>& constMatrix,
@@ -99,17 +118,29 @@ class ParallelRowDetection : public PresolveMethod<REAL>
 
    void
    computeRowHashes( const ConstraintMatrix<REAL>& constMatrix,
-                     unsigned int* rowhashes );
+                     const Vec<int>& rows, unsigned int* rowhashes );
+
+   void
+   computeSupportHashes( const ConstraintMatrix<REAL>& constMatrix,
+                         const Vec<int>& rows, std::size_t* rowhashes );
 
    void
    computeSupportId( const ConstraintMatrix<REAL>& constMatrix,
-                     unsigned int* supporthashes );
+                     const int* rows, int nrows, unsigned int* supportid );
 
    int
    determineBucketSize( int nRows, std::unique_ptr<unsigned int[]>& supportid,
-                        std::unique_ptr<unsigned int[]>& coefhash,
+                        const unsigned int* coefhash,
                         std::unique_ptr<int[]>& row, int i );
 
+   void
+   findParallelRowsInBlock( const Num<REAL>& num, int begin, int end,
+                            const ConstraintMatrix<REAL>& constMatrix,
+                            std::unique_ptr<unsigned int[]>& supportid,
+                            std::unique_ptr<int[]>& row,
+                            const Vec<int>& rowperm,
+                            Vec<Vec<int>>& stored_parallel_rows );
+
  public:
    ParallelRowDetection() : PresolveMethod<REAL>()
    {
@@ -118,6 +149,40 @@ class ParallelRowDetection : public PresolveMethod<REAL>
       this->setArgument( ArgumentType::kRedundant );
    }
 
+   void
+   compress( const Vec<int>& rowmap, const Vec<int>& colmap ) override
+   {
+      if( coefhashes.size() != rowmap.size() )
+      {
+         hashround = -1;
+         return;
+      }
+
+      compress_vector( rowmap, coefhashes );
+      compress_vector( rowmap, supporthashes );
+
+      for( int col = 0; col != (int) colmap.size(); ++col )
+      {
+         if( colmap[col] != col )
+         {
+            supportsvalid = false;
+            break;
+         }
+      }
+   }
+
+   bool
+   initialize( const Problem<REAL>& problem,
+               const PresolveOptions& presolveOptions ) override
+   {
+      coefhashes.clear();
+      supporthashes.clear();
+      hashround = -1;
+      supportsvalid = false;
+
+      return true;
+   }
+
    PresolveStatus
    execute( const Problem<REAL>& problem,
             const ProblemUpdate<REAL>& problemUpdate,
@@ -200,17 +265,20 @@ ParallelRowDetection<REAL>::findParallelRows(
 template <typename REAL>
 void
 ParallelRowDetection<REAL>::computeRowHashes(
-    const ConstraintMatrix<REAL>& constMatrix, unsigned int* rowhashes )
+    const ConstraintMatrix<REAL>& constMatrix, const Vec<int>& rows,
+    unsigned int* rowhashes )
 {
 #ifdef PAPILO_TBB
    tbb::parallel_for(
-       tbb::blocked_range<int>( 0, constMatrix.getNRows() ),
+       tbb::blocked_range<int>( 0, (int) rows.size() ),
        [&]( const tbb::blocked_range<int>& r ) {
-          for( int i = r.begin(); i != r.end(); ++i )
+          for( int k = r.begin(); k != r.end(); ++k )
 #else
-   for( int i = 0; i != constMatrix.getNRows(); ++i )
+   for( int k = 0; k != (int) rows.size(); ++k )
 #endif
           {
+             const int i = rows[k];
+
              // compute hash-value for coefficients
 
              auto rowcoefs = constMatrix.getRowCoefficients( i );
@@ -246,30 +314,88 @@ ParallelRowDetection<REAL>::computeRowHashes(
 #endif
 }
 
+template <typename REAL>
+void
+ParallelRowDetection<REAL>::computeSupportHashes(
+    const ConstraintMatrix<REAL>& constMatrix, const Vec<int>& rows,
+    std::size_t* rowhashes )
+{
+#ifdef PAPILO_TBB
+   tbb::parallel_for(
+       tbb::blocked_range<int>( 0, (int) rows.size() ),
+       [&]( const tbb::blocked_range<int>& r ) {
+          for( int k = r.begin(); k != r.end(); ++k )
+#else
+   for( int k = 0; k != (int) rows.size(); ++k )
+#endif
+          {
+             auto row = constMatrix.getRowCoefficients( rows[k] );
+             rowhashes[rows[k]] = SupportHashCompare::hash(
+                 std::make_pair( row.getLength(), row.getIndices() ) );
+          }
+#ifdef PAPILO_TBB
+       } );
+#endif
+}
+
 template <typename REAL>
 void
 ParallelRowDetection<REAL>::computeSupportId(
-    const ConstraintMatrix<REAL>& constMatrix, unsigned int* supporthashes )
+    const ConstraintMatrix<REAL>& constMatrix, const int* rows, int nrows,
+    unsigned int* supportid )
 {
-   using SupportMap =
-       HashMap<std::pair<int, const int*>, int, SupportHash, SupportEqual>;
+   using SupportMap = HashMap<int, int, SupportHash, SupportEqual>;
 
-   SupportMap supportMap(
-       static_cast<std::size_t>( constMatrix.getNRows() * 1.1 ) );
+   SupportMap supportMap( static_cast<std::size_t>( nrows * 1.1 ),
+                          SupportHash{ supporthashes.data() },
+                          SupportEqual{ &constMatrix } );
 
-   for( int i = 0; i < constMatrix.getNRows(); ++i )
+   for( int k = 0; k < nrows; ++k )
    {
-      auto row = constMatrix.getRowCoefficients( i );
-      int length = row.getLength();
-      const int* support = row.getIndices();
-
-      auto insResult =
-          supportMap.emplace( std::make_pair( length, support ), i );
+      const int i = rows[k];
+      auto insResult = supportMap.emplace( i, i );
 
       if( insResult.second )
-         supporthashes[i] = i;
+         supportid[i] = i;
       else // support already exists, use the previous support id
-         supporthashes[i] = insResult.first->second;
+         supportid[i] = insResult.first->second;
+   }
+}
+
+/// sorts the rows row[begin] to row[end - 1] of a block by support and
+/// coefficient hash and collects the sets of parallel rows among them
+template <typename REAL>
+void
+ParallelRowDetection<REAL>::findParallelRowsInBlock(
+    const Num<REAL>& num, int begin, int end,
+    const ConstraintMatrix<REAL>& constMatrix,
+    std::unique_ptr<unsigned int[]>& supportid, std::unique_ptr<int[]>& row,
+    const Vec<int>& rowperm, Vec<Vec<int>>& stored_parallel_rows )
+{
+   const unsigned int* coefhash = coefhashes.data();
+
+   pdqsort( row.get() + begin, row.get() + end, [&]( int a, int b ) {
+      return supportid[a] < supportid[b] ||
+             ( supportid[a] == supportid[b] && coefhash[a] < coefhash[b] ) ||
+             ( supportid[a] == supportid[b] && coefhash[a] == coefhash[b] &&
+               rowperm[a] < rowperm[b] );
+   } );
+
+   for( int i = begin; i < end; )
+   {
+      int bucketSize = determineBucketSize( end, supportid, coefhash, row, i );
+
+      // if more  than one row is in the bucket try to find parallel rows
+      if( bucketSize > 1 )
+      {
+         Vec<int> parallel_rows;
+         parallel_rows.reserve( bucketSize );
+         findParallelRows( num, row.get() + i, bucketSize, constMatrix,
+                           parallel_rows );
+         if( !parallel_rows.empty() )
+            stored_parallel_rows.emplace_back( parallel_rows );
+      }
+      i = bucketSize + i;
    }
 }
 
@@ -491,53 +617,103 @@ ParallelRowDetection<REAL>::execute( const Problem<REAL>& problem,
    assert( nRows > 0 );
 
    std::unique_ptr<unsigned int[]> supportid{ new unsigned int[nRows] };
-   std::unique_ptr<unsigned int[]> coefhash{ new unsigned int[nRows] };
    std::unique_ptr<int[]> row{ new int[nRows] };
 
+   if( (int) coefhashes.size() != nRows )
+   {
+      coefhashes.resize( nRows );
+      supporthashes.resize( nRows );
+      hashround = -1;
+   }
+
+   // only rehash the rows that were modified since the previous call
+   const Vec<int>& modifiedround = problemUpdate.getRowModifiedRounds();
+   Vec<int> coefrows;
+   Vec<int> supportrows;
+   for( int i = 0; i < nRows; ++i )
+   {
+      bool modified = hashround == -1 || modifiedround[i] >= hashround;
+      if( modified )
+         coefrows.push_back( i );
+      if( modified || !supportsvalid )
+         supportrows.push_back( i );
+   }
+
+   // parallel rows have the same support and hence lie in the same block of
+   // a bordered block diagonal structure, so the blocks are searched
+   // independently
+   const BlockStructure& blocks = problemUpdate.getBlockStructure();
+   Vec<int> blockstart;
+   Vec<int> blockrows;
+   if( blocks.hasBlocks() )
+      blocks.getRowPartition( blockrows, blockstart );
+   else
+      blockstart = { 0, nRows };
+   const int nblocks = (int) blockstart.size() - 1;
+
+   auto for_each_block = [nblocks]( const auto& f ) {
+#ifdef PAPILO_TBB
+      if( nblocks > 1 )
+      {
+         tbb::parallel_for( tbb::blocked_range<int>( 0, nblocks ),
+                            [&]( const tbb::blocked_range<int>& r ) {
+                               for( int b = r.begin(); b != r.end(); ++b )
+                                  f( b );
+                            } );
+         return;
+      }
+#endif
+      for( int b = 0; b < nblocks; ++b )
+         f( b );
+   };
+
+   auto compute_support_ids = [&]() {
+      for_each_block( [&]( int b ) {
+         computeSupportId( constMatrix, row.get() + blockstart[b],
+                           blockstart[b + 1] - blockstart[b],
+                           supportid.get() );
+      } );
+   };
+
 #ifdef PAPILO_TBB
    tbb::parallel_invoke(
-       [nRows, &row]() {
+       [nRows, &row, &blockrows]() {
           for( int i = 0; i < nRows; ++i )
-             row[i] = i;
+             row[i] = blockrows.empty() ? i : blockrows[i];
        },
-       [&constMatrix, &coefhash, this]() {
-          computeRowHashes( constMatrix, coefhash.get() );
+       [&constMatrix, &coefrows, this]() {
+          computeRowHashes( constMatrix, coefrows, coefhashes.data() );
        },
-       [&constMatrix, &supportid, this]() {
-          computeSupportId( constMatrix, supportid.get() );
+       [&constMatrix, &supportrows, this]() {
+          computeSupportHashes( constMatrix, supportrows,
+                                supporthashes.data() );
        } );
+   compute_support_ids();
 #else
    for( int i = 0; i < nRows; ++i )
-      row[i] = i;
-   computeRowHashes( constMatrix, coefhash.get() );
-   computeSupportId( constMatrix, supportid.get() );
+      row[i] = blockrows.empty() ? i : blockrows[i];
+   computeRowHashes( constMatrix, coefrows, coefhashes.data() );
+   computeSupportHashes( constMatrix, supportrows, supporthashes.data() );
+   compute_support_ids();
 #endif
 
-   pdqsort( row.get(), row.get() + nRows, [&]( int a, int b ) {
-      return supportid[a] < supportid[b] ||
-             ( supportid[a] == supportid[b] && coefhash[a] < coefhash[b] ) ||
-             ( supportid[a] == supportid[b] && coefhash[a] == coefhash[b] &&
-               rowperm[a] < rowperm[b] );
+   hashround = problemUpdate.getRound();
+   supportsvalid = true;
+
+   Vec<Vec<Vec<int>>> block_parallel_rows( nblocks );
+   for_each_block( [&]( int b ) {
+      findParallelRowsInBlock( num, blockstart[b], blockstart[b + 1],
+                               constMatrix, supportid, row, rowperm,
+                               block_parallel_rows[b] );
    } );
 
    Vec<Vec<int>> stored_parallel_rows;
-
-   for( int i = 0; i < nRows; )
+   for( Vec<Vec<int>>& parallel_rows : block_parallel_rows )
    {
-      int bucketSize =
-          determineBucketSize( nRows, supportid, coefhash, row, i );
-
-      // if more  than one row is in the bucket try to find parallel rows
-      if( bucketSize > 1 )
-      {
-         Vec<int> parallel_rows;
-         parallel_rows.reserve( bucketSize );
-         findParallelRows( num, row.get() + i, bucketSize, constMatrix,
-                           parallel_rows );
-         if( !parallel_rows.empty() )
-            stored_parallel_rows.emplace_back( parallel_rows );
-      }
-      i = bucketSize + i;
+      stored_parallel_rows.insert(
+          stored_parallel_rows.end(),
+          std::make_move_iterator( parallel_rows.begin() ),
+          std::make_move_iterator( parallel_rows.end() ) );
    }
 
    if( !stored_parallel_rows.empty() )
@@ -562,7 +738,7 @@ template <typename REAL>
 int
 ParallelRowDetection<REAL>::determineBucketSize(
     int nRows, std::unique_ptr<unsigned int[]>& supportid,
-    std::unique_ptr<unsigned int[]>& coefhash, std::unique_ptr<int[]>& row,
+    const unsigned int* coefhash, std::unique_ptr<int[]>& row,
     int i )
 {
    int j;
@@ -86,6 +86,19 @@ class Probing : public PresolveMethod<REAL>
       return true;
    }
 
+   void
+   getCheckpointData( Vec<int>& data ) const override
+   {
+      data = nprobed;
+   }
+
+   void
+   setCheckpointData( const Vec<int>& data ) override
+   {
+      assert( data.size() == nprobed.size() );
+      nprobed = data;
+   }
+
    void
    addPresolverParams( ParameterSet& paramSet ) override
    {
@@ -109,6 +122,8 @@ class Probing : public PresolveMethod<REAL>
           "minimum fraction of domain that needs to be reduced for continuous "
           "variables to accept a bound change in probing",
           mincontdomred, 0.0, 1.0 );
+
+      this->addTimeBudgetParameter( paramSet );
    }
 
    PresolveStatus
@@ -386,7 +401,7 @@ Probing<REAL>::execute( const Problem<REAL>& problem,
          for( int i = start; i < end; i++ )
 #endif
                 {
-                   if( PresolveMethod<REAL>::is_time_exceeded(
+                   if( this->is_budget_exceeded(
                            timer, problemUpdate.getPresolveOptions().tlim ) )
                       break;
                    const int col = probing_cands[i];
@@ -544,6 +559,7 @@ Probing<REAL>::execute( const Problem<REAL>& problem,
 
       working_limit -= amountofwork;
       working_limit += extrawork;
+      this->addWork( amountofwork );
 
       badge_size = static_cast<int>(
           ceil( badge_size * static_cast<double>( working_limit + extrawork ) /
@@ -555,7 +571,8 @@ Probing<REAL>::execute( const Problem<REAL>& problem,
 
       abort = n_useless >= consMatrix.getNnz() * 2 || working_limit < 0 ||
               current_badge_start == current_badge_end ||
-              PresolveMethod<REAL>::is_time_exceeded(timer, problemUpdate.getPresolveOptions().tlim );
+              this->is_work_exceeded() ||
+              this->is_budget_exceeded( timer, problemUpdate.getPresolveOptions().tlim );
    } while( !abort );
 
    PresolveStatus result = PresolveStatus::kUnchanged;
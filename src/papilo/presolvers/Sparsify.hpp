@@ -134,285 +134,289 @@ Sparsify<REAL>::execute( const Problem<REAL>& problem,
       equalities.emplace_back( i );
    }
 
-#ifdef PAPILO_TBB
-   tbb::combinable<SparsifyData> sparsifyData(
-       [nrows]() { return SparsifyData( nrows ); } );
-
-   tbb::parallel_for(
-       tbb::blocked_range<int>( 0, static_cast<int>( equalities.size() ) ),
-       [&]( const tbb::blocked_range<int>& r ) {
-          SparsifyData& localData = sparsifyData.local();
-          std::size_t sparsifyStart;
+   // looks for rows on which the given equality cancels nonzeros, the work
+   // is the number of visited nonzeros of the columns and candidate rows.
+   // The remaining equalities are skipped once presolve is interrupted.
+   auto sparsifyEquality = [&]( int eqrow, SparsifyData& data ) {
+      auto& candrowhits = data.candrowhits;
+      auto& candrows = data.candrows;
+      auto& sparsify = data.sparsify;
+      auto& reductionBuffer = data.reductionBuffer;
+      std::size_t sparsifyStart;
+      int64_t work = 0;
+
+      if( this->is_interrupted() )
+         return work;
+
+      auto rowvec = consmatrix.getRowCoefficients( eqrow );
+
+      int eqlen = rowvec.getLength();
+      const int* eqcols = rowvec.getIndices();
+      bool cancelint = true;
+      int minhits = eqlen - 1;
+      int nint = 0;
+      Message::debug(
+          this,
+          "trying sparsification with equality row {} of length {}\n",
+          eqrow, eqlen );
+
+      if( problem.getNumIntegralCols() != 0 )
+      {
+         int ncont = 0;
+         int nbin = 0;
 
-          auto& candrowhits = localData.candrowhits;
-          auto& candrows = localData.candrows;
-          auto& sparsify = localData.sparsify;
-          auto& reductionBuffer = localData.reductionBuffer;
+         for( int counter = 0; counter != eqlen; ++counter )
+         {
+            int col = eqcols[counter];
+
+            if( !cflags[col].test( ColFlag::kIntegral ) )
+               ++ncont;
+            else if( isBinaryCol( col ) )
+               ++nbin;
+            else
+            {
+               ++nint;
+               continue;
+            }
+
+            auto colvec = consmatrix.getColumnCoefficients( col );
+            const int* colrows = colvec.getIndices();
+            int collen = colvec.getLength();
+            work += collen;
+
+            for( int j = 0; j != collen; ++j )
+            {
+               int row = colrows[j];
+
+               if( row == eqrow )
+                  continue;
+
+               if( candrowhits[row] == 0 )
+               {
+                  if( nbin + ncont > 2 )
+                     continue;
+
+                  candrows.push_back( row );
+               }
+
+               ++candrowhits[row];
+            }
+         }
 
-          for( int i = r.begin(); i < r.end(); ++i )
-#else
-   SparsifyData s = SparsifyData(nrows);
-   auto& candrowhits = s.candrowhits;
-   auto& candrows = s.candrows;
-   auto& sparsify = s.sparsify;
-   std::size_t sparsifyStart;
-   auto& reductionBuffer = s.reductionBuffer;
-   for( int i = 0; i < (int) equalities.size(); ++i )
-#endif
-          {
-             int eqrow = equalities[i];
-
-             auto rowvec = consmatrix.getRowCoefficients( eqrow );
-
-             int eqlen = rowvec.getLength();
-             const int* eqcols = rowvec.getIndices();
-             bool cancelint = true;
-             int minhits = eqlen - 1;
-             int nint = 0;
-             Message::debug(
-                 this,
-                 "trying sparsification with equality row {} of length {}\n",
-                 eqrow, eqlen );
-
-             if( problem.getNumIntegralCols() != 0 )
-             {
-                int ncont = 0;
-                int nbin = 0;
-
-                for( int counter = 0; counter != eqlen; ++counter )
-                {
-                   int col = eqcols[counter];
-
-                   if( !cflags[col].test( ColFlag::kIntegral ) )
-                      ++ncont;
-                   else if( isBinaryCol( col ) )
-                      ++nbin;
-                   else
+         if( nbin + nint == 0 )
+         {
+            auto it = std::remove_if( candrows.begin(), candrows.end(),
+                                      [&]( int _r ) {
+                                         if( candrowhits[_r] < ncont - 1 )
+                                         {
+                                            candrowhits[_r] = 0;
+                                            return true;
+                                         }
+                                         return false;
+                                      } );
+
+            cancelint = false;
+
+            candrows.erase( it, candrows.end() );
+         }
+         else
+         {
+            auto it = std::remove_if(
+                candrows.begin(), candrows.end(), [&]( int _r ) {
+                   if( candrowhits[_r] < nbin + ncont - 1 )
                    {
-                      ++nint;
-                      continue;
+                      candrowhits[_r] = 0;
+                      return true;
                    }
+                   if( cancelint )
+                      candrowhits[_r] = nbin + ncont;
+                   return false;
+                } );
 
-                   auto colvec = consmatrix.getColumnCoefficients( col );
-                   const int* colrows = colvec.getIndices();
-                   int collen = colvec.getLength();
-
-                   for( int j = 0; j != collen; ++j )
-                   {
-                      int row = colrows[j];
-
-                      if( row == eqrow )
-                         continue;
-
-                      if( candrowhits[row] == 0 )
-                      {
-                         if( nbin + ncont > 2 )
-                            continue;
+            candrows.erase( it, candrows.end() );
 
-                         candrows.push_back( row );
-                      }
+            minhits = eqlen;
+         }
+      }
 
-                      ++candrowhits[row];
-                   }
-                }
-
-                if( nbin + nint == 0 )
-                {
-                   auto it = std::remove_if( candrows.begin(), candrows.end(),
-                                             [&]( int _r ) {
-                                                if( candrowhits[_r] < ncont - 1 )
-                                                {
-                                                   candrowhits[_r] = 0;
-                                                   return true;
-                                                }
-                                                return false;
-                                             } );
-
-                   cancelint = false;
-
-                   candrows.erase( it, candrows.end() );
-                }
-                else
-                {
-                   auto it = std::remove_if(
-                       candrows.begin(), candrows.end(), [&]( int _r ) {
-                          if( candrowhits[_r] < nbin + ncont - 1 )
-                          {
-                             candrowhits[_r] = 0;
-                             return true;
-                          }
-                          if( cancelint )
-                             candrowhits[_r] = nbin + ncont;
-                          return false;
-                       } );
-
-                   candrows.erase( it, candrows.end() );
-
-                   minhits = eqlen;
-                }
-             }
-
-             if( problem.getNumIntegralCols() == 0 || nint != 0 )
-             {
-                for( int counter = 0; counter != eqlen; ++counter )
-                {
-                   int col = eqcols[counter];
-
-                   if( problem.getNumIntegralCols() != 0 &&
-                       ( !cflags[col].test( ColFlag::kIntegral ) ||
-                         isBinaryCol( col ) ) )
-                      continue;
-
-                   auto colvec = consmatrix.getColumnCoefficients( col );
-                   const int* colrows = colvec.getIndices();
-                   int collen = colvec.getLength();
-
-                   for( int j = 0; j != collen; ++j )
-                   {
-                      int row = colrows[j];
+      if( problem.getNumIntegralCols() == 0 || nint != 0 )
+      {
+         for( int counter = 0; counter != eqlen; ++counter )
+         {
+            int col = eqcols[counter];
 
-                      if( row == eqrow )
-                         continue;
+            if( problem.getNumIntegralCols() != 0 &&
+                ( !cflags[col].test( ColFlag::kIntegral ) ||
+                  isBinaryCol( col ) ) )
+               continue;
 
-                      if( candrowhits[row] == 0 )
-                      {
-                         if( counter > eqlen - minhits )
-                            continue;
+            auto colvec = consmatrix.getColumnCoefficients( col );
+            const int* colrows = colvec.getIndices();
+            int collen = colvec.getLength();
+            work += collen;
 
-                         candrows.push_back( row );
-                      }
+            for( int j = 0; j != collen; ++j )
+            {
+               int row = colrows[j];
 
-                      ++candrowhits[row];
-                   }
-                }
-
-                auto it = std::remove_if( candrows.begin(), candrows.end(),
-                                          [&]( int _r ) {
-                                             if( candrowhits[_r] < minhits )
-                                             {
-                                                candrowhits[_r] = 0;
-                                                return true;
-                                             }
-                                             return false;
-                                          } );
-
-                candrows.erase( it, candrows.end() );
-             }
-
-             if( !candrows.empty() )
-             {
-                Vec<REAL> scales( eqlen );
-                const REAL* eqvals = rowvec.getValues();
-
-                sparsifyStart = sparsify.size();
-                sparsify.reserve( sparsifyStart + candrows.size() );
-
-                for( int candrow : candrows )
-                {
-                   auto candrowvec = consmatrix.getRowCoefficients( candrow );
-                   const int* candcols = candrowvec.getIndices();
-                   const REAL* candvals = candrowvec.getValues();
-                   int candlen = candrowvec.getLength();
-
-                   if( !cancelint && candrowhits[candrow] != eqlen )
-                   {
-                      bool has_integral = false;
-                      for( int j = 0; j != candlen; ++j )
-                      {
-                         if( cflags[candcols[j]].test( ColFlag::kIntegral ) )
-                         {
-                            has_integral = true;
-                            break;
-                         }
-                      }
-
-                      if( has_integral )
-                         continue;
-                   }
+               if( row == eqrow )
+                  continue;
 
-                   int h = 0;
-                   int j = 0;
+               if( candrowhits[row] == 0 )
+               {
+                  if( counter > eqlen - minhits )
+                     continue;
 
-                   int currcancel = 0;
+                  candrows.push_back( row );
+               }
 
-                   while( h != eqlen && j != candlen )
-                   {
-                      if( eqcols[h] == candcols[j] )
-                      {
-                         scales[h] = -candvals[j] / eqvals[h];
-
-                         ++h;
-                         ++j;
-                      }
-                      else if( eqcols[h] < candcols[j] )
-                      {
-                         --currcancel;
-                         scales[h] = 0;
-                         ++h;
-                      }
-                      else
-                      {
-                         ++j;
-                      }
-                   }
+               ++candrowhits[row];
+            }
+         }
 
-                   while( h != eqlen )
-                   {
-                      --currcancel;
-                      scales[h] = 0;
-                      ++h;
-                   }
+         auto it = std::remove_if( candrows.begin(), candrows.end(),
+                                   [&]( int _r ) {
+                                      if( candrowhits[_r] < minhits )
+                                      {
+                                         candrowhits[_r] = 0;
+                                         return true;
+                                      }
+                                      return false;
+                                   } );
+
+         candrows.erase( it, candrows.end() );
+      }
 
-                   pdqsort( scales.begin(), scales.end() );
+      if( !candrows.empty() )
+      {
+         Vec<REAL> scales( eqlen );
+         const REAL* eqvals = rowvec.getValues();
 
-                   int bestcancel = 0;
-                   REAL bestscale = 0;
+         sparsifyStart = sparsify.size();
+         sparsify.reserve( sparsifyStart + candrows.size() );
 
-                   for( int k = 0; k != eqlen - 1; ++k )
-                   {
-                      if( scales[k] == 0 || abs( scales[k] ) > maxscale )
-                         continue;
-
-                      int ncancel = currcancel;
-
-                      for( int l = k + 1; l != eqlen; ++l )
-                      {
-                         if( num.isEq( scales[k], scales[l] ) )
-                            ++ncancel;
-                         else
-                            break;
-                      }
-
-                      if( ncancel > bestcancel )
-                      {
-                         bestcancel = ncancel;
-                         bestscale = scales[k];
-                      }
-                   }
+         for( int candrow : candrows )
+         {
+            auto candrowvec = consmatrix.getRowCoefficients( candrow );
+            const int* candcols = candrowvec.getIndices();
+            const REAL* candvals = candrowvec.getValues();
+            int candlen = candrowvec.getLength();
+            work += candlen + eqlen;
+
+            if( !cancelint && candrowhits[candrow] != eqlen )
+            {
+               bool has_integral = false;
+               for( int j = 0; j != candlen; ++j )
+               {
+                  if( cflags[candcols[j]].test( ColFlag::kIntegral ) )
+                  {
+                     has_integral = true;
+                     break;
+                  }
+               }
+
+               if( has_integral )
+                  continue;
+            }
+
+            int h = 0;
+            int j = 0;
+
+            int currcancel = 0;
+
+            while( h != eqlen && j != candlen )
+            {
+               if( eqcols[h] == candcols[j] )
+               {
+                  scales[h] = -candvals[j] / eqvals[h];
+
+                  ++h;
+                  ++j;
+               }
+               else if( eqcols[h] < candcols[j] )
+               {
+                  --currcancel;
+                  scales[h] = 0;
+                  ++h;
+               }
+               else
+               {
+                  ++j;
+               }
+            }
+
+            while( h != eqlen )
+            {
+               --currcancel;
+               scales[h] = 0;
+               ++h;
+            }
+
+            pdqsort( scales.begin(), scales.end() );
+
+            int bestcancel = 0;
+            REAL bestscale = 0;
+
+            for( int k = 0; k != eqlen - 1; ++k )
+            {
+               if( scales[k] == 0 || abs( scales[k] ) > maxscale )
+                  continue;
+
+               int ncancel = currcancel;
+
+               for( int l = k + 1; l != eqlen; ++l )
+               {
+                  if( num.isEq( scales[k], scales[l] ) )
+                     ++ncancel;
+                  else
+                     break;
+               }
+
+               if( ncancel > bestcancel )
+               {
+                  bestcancel = ncancel;
+                  bestscale = scales[k];
+               }
+            }
+
+            if( bestcancel > 0 )
+            {
+               Message::debug(
+                   this,
+                   "equation row{} cancels {} nonzeros on row{} "
+                   "with scale {}\n",
+                   eqrow, bestcancel, candrow, bestscale );
+
+               sparsify.emplace_back( candrow, bestscale );
+            }
+         }
 
-                   if( bestcancel > 0 )
-                   {
-                      Message::debug(
-                          this,
-                          "equation row{} cancels {} nonzeros on row{} "
-                          "with scale {}\n",
-                          eqrow, bestcancel, candrow, bestscale );
+         for( int candrow : candrows )
+            candrowhits[candrow] = 0;
+         candrows.clear();
 
-                      sparsify.emplace_back( candrow, bestscale );
-                   }
-                }
+         if( sparsify.size() != sparsifyStart )
+            reductionBuffer.emplace_back( eqrow, int( sparsifyStart ),
+                                          int( sparsify.size() ) );
+      }
+      return work;
+   };
 
-                for( int candrow : candrows )
-                   candrowhits[candrow] = 0;
-                candrows.clear();
+   this->addWork( static_cast<double>( nrows ) );
 
-                if( sparsify.size() != sparsifyStart )
-                   reductionBuffer.emplace_back( eqrow, int( sparsifyStart ),
-                                                 int( sparsify.size() ) );
-             }
-          }
 #ifdef PAPILO_TBB
+   tbb::combinable<SparsifyData> sparsifyData(
+       [nrows]() { return SparsifyData( nrows ); } );
+
+   this->for_each_within_work_budget(
+       static_cast<int>( equalities.size() ), true, [&]( int i ) {
+          return sparsifyEquality( equalities[i], sparsifyData.local() );
        } );
+#else
+   SparsifyData s = SparsifyData( nrows );
+   this->for_each_within_work_budget(
+       static_cast<int>( equalities.size() ), false,
+       [&]( int i ) { return sparsifyEquality( equalities[i], s ); } );
 #endif
    int nreductions = 0;
 #ifdef PAPILO_TBB
@@ -23,6 +23,7 @@
 #ifndef _PAPILO_VERI_CERTIFICATE_INTERFACE_HPP_
 #define _PAPILO_VERI_CERTIFICATE_INTERFACE_HPP_
 
+#include "papilo/core/BatchMatrixBuffer.hpp"
 #include "papilo/core/Problem.hpp"
 #include "papilo/misc/Num.hpp"
 #include "papilo/misc/Vec.hpp"
@@ -59,12 +60,12 @@ class CertificateInterface
 
    virtual void
    change_upper_bound( REAL val, int col, const Problem<REAL>& problem,
-                       const Vec<int>& var_mapping, MatrixBuffer<REAL>& matrix_buffer,
+                       const Vec<int>& var_mapping, BatchMatrixBuffer<REAL>& matrix_buffer,
                        ArgumentType argument = ArgumentType::kPrimal ) = 0;
 
    virtual void
    change_lower_bound( REAL val, int col, const Problem<REAL>& problem,
-                       const Vec<int>& var_mapping, MatrixBuffer<REAL>& matrix_buffer,
+                       const Vec<int>& var_mapping, BatchMatrixBuffer<REAL>& matrix_buffer,
                        ArgumentType argument = ArgumentType::kPrimal ) = 0;
 
    virtual void
@@ -60,14 +60,14 @@ class EmptyCertificate : public CertificateInterface<REAL>
 
    void
    change_upper_bound( REAL val, int col, const Problem<REAL>& problem,
-                       const Vec<int>& var_mapping, MatrixBuffer<REAL>& matrix_buffer,
+                       const Vec<int>& var_mapping, BatchMatrixBuffer<REAL>& matrix_buffer,
                        ArgumentType argument = ArgumentType::kPrimal )
    {
    }
 
    void
    change_lower_bound( REAL val, int col, const Problem<REAL>& problem,
-                       const Vec<int>& var_mapping, MatrixBuffer<REAL>& matrix_buffer,
+                       const Vec<int>& var_mapping, BatchMatrixBuffer<REAL>& matrix_buffer,
                        ArgumentType argument = ArgumentType::kPrimal )
    {
    }
@@ -269,7 +269,7 @@ class VeriPb : public CertificateInterface<REAL>
 
    void
    change_upper_bound( REAL val, int col, const Problem<REAL>& problem,
-                       const Vec<int>& var_mapping, MatrixBuffer<REAL>& matrix_buffer,
+                       const Vec<int>& var_mapping, BatchMatrixBuffer<REAL>& matrix_buffer,
                        ArgumentType argument = ArgumentType::kPrimal ) override
    {
 #if VERIPB_VERSION == 1
@@ -342,7 +342,7 @@ class VeriPb : public CertificateInterface<REAL>
                                  scale_factor[row] ) );
          REAL unscaled_row_value;
          // check if the matrix coefficients were updated since the last call
-         const MatrixEntry<REAL>* entry = matrix_buffer.template findEntry<false>( row, col);
+         const BatchMatrixEntry<REAL>* entry = matrix_buffer.template findEntry<false>( row, col);
          if( entry != nullptr )
             unscaled_row_value = entry->val;
          else
@@ -431,7 +431,7 @@ class VeriPb : public CertificateInterface<REAL>
 
    void
    change_lower_bound( REAL val, int col, const Problem<REAL>& problem,
-                       const Vec<int>& var_mapping, MatrixBuffer<REAL>& matrix_buffer,
+                       const Vec<int>& var_mapping, BatchMatrixBuffer<REAL>& matrix_buffer,
                        ArgumentType argument = ArgumentType::kPrimal ) override
    {
 #if VERIPB_VERSION == 1
@@ -679,6 +679,59 @@ papilo_solver_set_trace_callback( PAPILO_SOLVER* solver,
    solver->presolve.message().setOutputCallback( thetracecb, usrptr );
 }
 
+void
+papilo_solver_set_progress_callback(
+    PAPILO_SOLVER* solver,
+    int ( *theprogresscb )( const PAPILO_PRESOLVE_PROGRESS* progress,
+                            void* usrptr ),
+    void* usrptr )
+{
+   if( theprogresscb == nullptr )
+   {
+      solver->presolve.setProgressCallback( nullptr );
+      return;
+   }
+
+   solver->presolve.setProgressCallback(
+       [theprogresscb, usrptr]( const PresolveProgress& progress ) {
+          const int npresolvers =
+              static_cast<int>( progress.presolvers.size() );
+          Vec<const char*> names( npresolvers );
+          Vec<unsigned int> ncalls( npresolvers );
+          Vec<double> times( npresolvers );
+          for( int i = 0; i != npresolvers; ++i )
+          {
+             names[i] = progress.presolvers[i].name.c_str();
+             ncalls[i] = progress.presolvers[i].ncalls;
+             times[i] = progress.presolvers[i].time;
+          }
+
+          PAPILO_PRESOLVE_PROGRESS cprogress;
+          cprogress.nrounds = progress.stats.nrounds;
+          cprogress.nactiverows = progress.nactiverows;
+          cprogress.nactivecols = progress.nactivecols;
+          cprogress.nnz = progress.nnz;
+          cprogress.ndeletedrows = progress.stats.ndeletedrows;
+          cprogress.ndeletedcols = progress.stats.ndeletedcols;
+          cprogress.nboundchgs = progress.stats.nboundchgs;
+          cprogress.nsidechgs = progress.stats.nsidechgs;
+          cprogress.ncoefchgs = progress.stats.ncoefchgs;
+          cprogress.presolvetime = progress.stats.presolvetime;
+          cprogress.npresolvers = npresolvers;
+          cprogress.presolvernames = names.data();
+          cprogress.presolverncalls = ncalls.data();
+          cprogress.presolvertimes = times.data();
+
+          return theprogresscb( &cprogress, usrptr ) != 0;
+       } );
+}
+
+void
+papilo_solver_interrupt_presolve( PAPILO_SOLVER* solver )
+{
+   solver->presolve.interrupt();
+}
+
 void
 papilo_solver_free( PAPILO_SOLVER* solver )
 {
@@ -182,6 +182,42 @@ extern "C"
                                                            void* usrptr ),
                                      void* usrptr );
 
+   /// State of presolve at the end of a round. The arrays have size
+   /// npresolvers and stay valid only during the call of the progress
+   /// callback.
+   typedef struct
+   {
+      int nrounds;
+      int nactiverows;
+      int nactivecols;
+      int64_t nnz;
+      int ndeletedrows;
+      int ndeletedcols;
+      int nboundchgs;
+      int nsidechgs;
+      int ncoefchgs;
+      double presolvetime;
+      int npresolvers;
+      const char* const* presolvernames;
+      const unsigned int* presolverncalls;
+      const double* presolvertimes;
+   } PAPILO_PRESOLVE_PROGRESS;
+
+   /// Set callback that is called after each presolve round. If the callback
+   /// returns a nonzero value presolve stops and the reductions found so far
+   /// are kept. If the callback is set to NULL no callback is called.
+   PAPILOLIB_EXPORT void
+   papilo_solver_set_progress_callback(
+       PAPILO_SOLVER* solver,
+       int ( *theprogresscb )( const PAPILO_PRESOLVE_PROGRESS* progress,
+                               void* usrptr ),
+       void* usrptr );
+
+   /// Stop a running presolve at the next safe point. Can be called from
+   /// another thread while papilo_solver_start() is running.
+   PAPILOLIB_EXPORT void
+   papilo_solver_interrupt_presolve( PAPILO_SOLVER* solver );
+
    /// Free the problem datastructure
    PAPILOLIB_EXPORT void
    papilo_solver_free( PAPILO_SOLVER* );
@@ -0,0 +1,109 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "papilo/core/AdaptiveSelection.hpp"
+#include "papilo/external/catch/catch.hpp"
+#include <limits>
+
+using namespace papilo;
+
+TEST_CASE( "adaptive-selection-probes-skipped-presolver-again", "[core]" )
+{
+   const double inf = std::numeric_limits<double>::max();
+   AdaptiveSelection selection;
+   selection.resize( 2 );
+
+   // presolver 0 finds 10 reductions per call, presolver 1 none
+   selection.update( 0, 2, 2.0, 0.0, 20 );
+   selection.update( 1, 2, 2.0, 0.0, 0 );
+   Vec<int> candidates{ 0, 1 };
+
+   Vec<int> skiprounds = selection.select( candidates, 1.0, inf, inf );
+   REQUIRE( skiprounds[0] == 0 );
+   REQUIRE( skiprounds[1] == 1 );
+
+   // once the skipped rounds are over the presolver runs again even though
+   // its estimate did not change
+   skiprounds = selection.select( candidates, 1.0, inf, inf );
+   REQUIRE( skiprounds[1] == 0 );
+
+   // the probing call is unproductive, so it is skipped for longer
+   selection.update( 1, 3, 3.0, 0.0, 0 );
+   skiprounds = selection.select( candidates, 1.0, inf, inf );
+   REQUIRE( skiprounds[1] == 2 );
+
+   // the number of skipped rounds is bounded
+   const int maxskiprounds = AdaptiveSelection::MAX_SKIP_ROUNDS;
+   for( int i = 0; i != 2 * maxskiprounds; ++i )
+   {
+      skiprounds = selection.select( candidates, 1.0, inf, inf );
+      REQUIRE( skiprounds[1] == 0 );
+      selection.update( 1, selection.getEstimate( 1 ).ncalls + 1,
+                        selection.getEstimate( 1 ).exectime + 1.0, 0.0, 0 );
+      skiprounds = selection.select( candidates, 1.0, inf, inf );
+      REQUIRE( skiprounds[1] > 0 );
+      REQUIRE( skiprounds[1] <= maxskiprounds );
+   }
+
+   // the presolver becomes productive again: the probing call finds 30
+   // reductions and the decayed estimate lets it run in the next rounds
+   skiprounds = selection.select( candidates, 1.0, inf, inf );
+   REQUIRE( skiprounds[1] == 0 );
+   const PresolverEstimate& estimate = selection.getEstimate( 1 );
+   selection.update( 1, estimate.ncalls + 1, estimate.exectime + 1.0, 0.0,
+                     30 );
+   skiprounds = selection.select( candidates, 1.0, inf, inf );
+   REQUIRE( skiprounds[1] == 0 );
+   REQUIRE( selection.getEstimate( 1 ).nskips == 0 );
+}
+
+TEST_CASE( "adaptive-selection-ranks-by-payoff-per-budget", "[core]" )
+{
+   const double inf = std::numeric_limits<double>::max();
+   AdaptiveSelection selection;
+   selection.resize( 3 );
+
+   // all presolvers are productive, but each call takes 4 of the remaining
+   // 10 seconds, so only the two with the most reductions per second run
+   selection.update( 0, 2, 8.0, 0.0, 4 );
+   selection.update( 1, 2, 8.0, 0.0, 40 );
+   selection.update( 2, 2, 8.0, 0.0, 20 );
+   Vec<int> candidates{ 0, 1, 2 };
+
+   Vec<int> skiprounds = selection.select( candidates, 0.1, 10.0, inf );
+   REQUIRE( skiprounds[0] > 0 );
+   REQUIRE( skiprounds[1] == 0 );
+   REQUIRE( skiprounds[2] == 0 );
+
+   // a work limit is shared in the same way: presolver 1 is the cheapest
+   // per reduction in work units
+   AdaptiveSelection worklimited;
+   worklimited.resize( 3 );
+   worklimited.update( 0, 2, 2.0, 200.0, 20 );
+   worklimited.update( 1, 2, 2.0, 20.0, 20 );
+   worklimited.update( 2, 2, 2.0, 120.0, 20 );
+
+   skiprounds = worklimited.select( candidates, 0.1, inf, 100.0 );
+   REQUIRE( skiprounds[0] > 0 );
+   REQUIRE( skiprounds[1] == 0 );
+   REQUIRE( skiprounds[2] == 0 );
+}
@@ -20,12 +20,22 @@
 /*                                                                           */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#include "papilo/core/BatchMatrixBuffer.hpp"
 #include "papilo/core/MatrixBuffer.hpp"
 #include "papilo/external/catch/catch.hpp"
+#include "papilo/misc/Timer.hpp"
 #include "papilo/misc/fmt.hpp"
+#include <random>
 
 using namespace papilo;
 
+static Vec<Triplet<double>>
+setupRandomEntries( int nrows, int ncols, int nentries, std::mt19937& rng );
+
+template <bool RowMajor, typename Buffer>
+static double
+traverseBuffer( const Buffer& M );
+
 template <bool StorageOrder>
 bool
 checkHeapProperty( MatrixBuffer<double>& M )
@@ -165,3 +175,230 @@ TEST_CASE( "matrix-buffer", "[core]" )
 
    REQUIRE( stack.size() == 1 );
 }
+
+TEST_CASE( "batch-matrix-buffer", "[core]" )
+{
+   std::mt19937 rng( 42 );
+
+   // cover the comparison sort and the radix sort
+   for( int nentries : { 13, 5000 } )
+   {
+      Vec<Triplet<double>> entries =
+          setupRandomEntries( 300, 7000, nentries, rng );
+
+      MatrixBuffer<double> tree;
+      BatchMatrixBuffer<double> batch;
+
+      for( const Triplet<double>& entry : entries )
+      {
+         tree.addEntry( std::get<0>( entry ), std::get<1>( entry ),
+                        std::get<2>( entry ) );
+         batch.addEntry( std::get<0>( entry ), std::get<1>( entry ),
+                         std::get<2>( entry ) );
+      }
+
+      REQUIRE( batch.getNnz() == tree.getNnz() );
+
+      // findEntry works before and after the entries are sorted
+      const Triplet<double>& last = entries.back();
+      auto found = batch.findEntry<false>( std::get<0>( last ),
+                                           std::get<1>( last ) );
+      REQUIRE( found != nullptr );
+      REQUIRE( found->val == std::get<2>( last ) );
+
+      SmallVec<int, 32> treestack;
+      SmallVec<int, 32> batchstack;
+
+      auto treeit = tree.begin<true>( treestack );
+      auto batchit = batch.begin<true>( batchstack );
+
+      while( treeit != tree.end() )
+      {
+         REQUIRE( batchit != batch.end() );
+         REQUIRE( batchit->row == treeit->row );
+         REQUIRE( batchit->col == treeit->col );
+         REQUIRE( batchit->val == treeit->val );
+         treeit = tree.next<true>( treestack );
+         batchit = batch.next<true>( batchstack );
+      }
+      REQUIRE( batchit == batch.end() );
+
+      treeit = tree.begin<false>( treestack );
+      batchit = batch.begin<false>( batchstack );
+
+      while( treeit != tree.end() )
+      {
+         REQUIRE( batchit != batch.end() );
+         REQUIRE( batchit->row == treeit->row );
+         REQUIRE( batchit->col == treeit->col );
+         REQUIRE( batchit->val == treeit->val );
+         treeit = tree.next<false>( treestack );
+         batchit = batch.next<false>( batchstack );
+      }
+      REQUIRE( batchit == batch.end() );
+
+      for( const Triplet<double>& entry : entries )
+      {
+         found = batch.findEntry<true>( std::get<0>( entry ),
+                                        std::get<1>( entry ) );
+         REQUIRE( found != nullptr );
+         REQUIRE( found->val == std::get<2>( entry ) );
+      }
+      REQUIRE( batch.findEntry<true>( 300, 0 ) == nullptr );
+
+      SparseStorage<double> treecsc = tree.buildCSC( 300, 7000 );
+      SparseStorage<double> batchcsc = batch.buildCSC( 300, 7000 );
+      REQUIRE( batchcsc.getValuesVec() == treecsc.getValuesVec() );
+      REQUIRE( batchcsc.getColumnsVec() == treecsc.getColumnsVec() );
+
+      batch.clear();
+      REQUIRE( batch.empty() );
+   }
+}
+
+TEST_CASE( "batch-matrix-buffer-parallel-sort-is-stable", "[core]" )
+{
+   // enough entries for several chunks of the radix sort, positions may
+   // repeat and the values give the insertion order
+   const int nentries = 100000;
+   std::mt19937 rng( 7 );
+   std::uniform_int_distribution<int> row( 0, 299 );
+   std::uniform_int_distribution<int> col( 0, 6999 );
+
+   BatchMatrixBuffer<double> batch;
+   for( int i = 1; i <= nentries; ++i )
+      batch.addEntry( row( rng ), col( rng ), double( i ) );
+
+   auto check_order = [&]( auto rowmajor ) {
+      constexpr bool RowMajor = decltype( rowmajor )::value;
+      SmallVec<int, 32> stack;
+      auto it = batch.begin<RowMajor>( stack );
+      auto prev = it;
+      int n = 0;
+
+      while( it != batch.end() )
+      {
+         if( n != 0 )
+         {
+            auto key = RowMajor ? std::make_pair( it->row, it->col )
+                                : std::make_pair( it->col, it->row );
+            auto prevkey = RowMajor ? std::make_pair( prev->row, prev->col )
+                                    : std::make_pair( prev->col, prev->row );
+            REQUIRE( prevkey <= key );
+            if( prevkey == key )
+               REQUIRE( prev->val < it->val );
+         }
+         prev = it;
+         it = batch.next<RowMajor>( stack );
+         ++n;
+      }
+      REQUIRE( n == nentries );
+
+      // findEntry returns the most recent entry of a position
+      if( n != 0 )
+      {
+         auto found = batch.findEntry<RowMajor>( prev->row, prev->col );
+         REQUIRE( found != nullptr );
+         REQUIRE( found->val == prev->val );
+      }
+   };
+
+#ifdef PAPILO_TBB
+   tbb::task_arena( 4 ).execute( [&]() {
+      batch.sort();
+      check_order( std::true_type() );
+      check_order( std::false_type() );
+   } );
+#else
+   check_order( std::true_type() );
+   check_order( std::false_type() );
+#endif
+}
+
+TEST_CASE( "matrix-buffer-benchmark", "[.][benchmark]" )
+{
+   std::mt19937 rng( 7 );
+
+   fmt::print( "{:>10} {:>12} {:>12} {:>8}\n", "entries", "tree[s]",
+               "batch[s]", "speedup" );
+
+   for( int nentries : { 1000, 10000, 100000, 1000000 } )
+   {
+      const int nrows = nentries / 4;
+      const int ncols = nentries / 8;
+      Vec<Triplet<double>> entries =
+          setupRandomEntries( nrows, ncols, nentries, rng );
+
+      double treetime = 0.0;
+      double batchtime = 0.0;
+      double checksum = 0.0;
+      {
+         Timer timer( treetime );
+         MatrixBuffer<double> tree;
+         tree.reserve( nentries );
+         for( const Triplet<double>& entry : entries )
+            tree.addEntry( std::get<0>( entry ), std::get<1>( entry ),
+                           std::get<2>( entry ) );
+         checksum += traverseBuffer<true>( tree );
+         checksum += traverseBuffer<false>( tree );
+      }
+      {
+         Timer timer( batchtime );
+         BatchMatrixBuffer<double> batch;
+         batch.reserve( nentries );
+         for( const Triplet<double>& entry : entries )
+            batch.addEntry( std::get<0>( entry ), std::get<1>( entry ),
+                            std::get<2>( entry ) );
+         checksum -= traverseBuffer<true>( batch );
+         checksum -= traverseBuffer<false>( batch );
+      }
+
+      fmt::print( "{:>10} {:>12.4f} {:>12.4f} {:>8.2f}   (checksum {:.1e})\n",
+                  nentries, treetime, batchtime,
+                  batchtime > 0 ? treetime / batchtime : 0.0, checksum );
+   }
+}
+
+template <bool RowMajor, typename Buffer>
+static double
+traverseBuffer( const Buffer& M )
+{
+   SmallVec<int, 32> stack;
+   double sum = 0.0;
+   int previous = -1;
+
+   for( auto it = M.template begin<RowMajor>( stack ); it != M.end();
+        it = M.template next<RowMajor>( stack ) )
+   {
+      // weight the values by their position to detect a wrong order
+      sum += it->val * ( RowMajor ? it->row : it->col );
+      previous = RowMajor ? it->row : it->col;
+   }
+
+   return sum + previous;
+}
+
+static Vec<Triplet<double>>
+setupRandomEntries( int nrows, int ncols, int nentries, std::mt19937& rng )
+{
+   std::uniform_int_distribution<int> row( 0, nrows - 1 );
+   std::uniform_int_distribution<int> col( 0, ncols - 1 );
+
+   // draw distinct positions, as the coefficient changes of a round are
+   // distinct
+   Vec<Triplet<double>> entries;
+   Vec<std::pair<int, int>> positions;
+
+   while( (int) entries.size() < nentries )
+   {
+      std::pair<int, int> pos( row( rng ), col( rng ) );
+      auto it = std::lower_bound( positions.begin(), positions.end(), pos );
+      if( it != positions.end() && *it == pos )
+         continue;
+      positions.insert( it, pos );
+      entries.emplace_back( pos.first, pos.second,
+                            double( entries.size() + 1 ) );
+   }
+
+   return entries;
+}
@@ -20,10 +20,14 @@
 /*                                                                           */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#include "papilo/core/BatchPresolve.hpp"
 #include "papilo/core/Presolve.hpp"
+#include "papilo/core/PresolveCache.hpp"
+#include "papilo/core/PresolveCheckpoint.hpp"
 #include "papilo/external/catch/catch.hpp"
 #include "papilo/core/Problem.hpp"
 #include "papilo/core/ProblemBuilder.hpp"
+#include "papilo/core/ProblemDelta.hpp"
 #include "papilo/core/Reductions.hpp"
 #include "papilo/presolvers/ImplIntDetection.hpp"
 
@@ -67,7 +71,7 @@ lhs()
    return papilo::Vec<double>{ rhs()[0], rhs()[1] };
 }
 
-std::vector<int>
+papilo::Vec<int>
 row_sizes()
 {
    return papilo::Vec<int>{ 3, 2 };
@@ -76,6 +80,12 @@ row_sizes()
 papilo::Problem<double>
 setupProblemWithMultiplePresolvingOptions();
 
+papilo::Problem<double>
+setupProblemWithTwoComponents();
+
+papilo::Problem<double>
+reverseRowsAndCols( const papilo::Problem<double>& problem );
+
 std::pair<std::pair<papilo::Problem<double>, papilo::PostsolveStorage<double>>,
           std::pair<int, int>>
 applyReductions( const papilo::Reductions<double>& reductions,
@@ -122,9 +132,9 @@ TEST_CASE( "happy-path-replace-variable", "[core]" )
 
    papilo::Problem<double> problem = pair.first.first;
 
-   std::vector<double> expected_objective{ 0.0, -2.0, 1.0, 1.0 };
-   std::vector<int> expected_colsizes{ ELIMINATED, 1, 2, 1 };
-   std::vector<int> expected_rowsizes{ 2, 2 };
+   papilo::Vec<double> expected_objective{ 0.0, -2.0, 1.0, 1.0 };
+   papilo::Vec<int> expected_colsizes{ ELIMINATED, 1, 2, 1 };
+   papilo::Vec<int> expected_rowsizes{ 2, 2 };
 
    REQUIRE( problem.getObjective().coefficients == expected_objective );
    REQUIRE( problem.getConstraintMatrix().getColSizes() == expected_colsizes );
@@ -165,8 +175,8 @@ TEST_CASE( "happy-path-substitute-matrix-coefficient-into-objective", "[core]" )
        pair = applyReductions( reductions, false );
    Problem<double> problem = pair.first.first;
 
-   std::vector<double> expected_objective{ 3.0, 1.0, 0.0, 0.0 };
-   std::vector<double> expected_upper_bounds{ 1.0, 1.0, 1.0, 0.0 };
+   papilo::Vec<double> expected_objective{ 3.0, 1.0, 0.0, 0.0 };
+   papilo::Vec<double> expected_upper_bounds{ 1.0, 1.0, 1.0, 0.0 };
 
    REQUIRE( problem.getObjective().coefficients == expected_objective );
    REQUIRE( problem.getNRows() == 2 );
@@ -202,8 +212,8 @@ TEST_CASE( "happy-path-aggregate-free-column", "[core]" )
    REQUIRE( result.second == 1 );
    Problem<double> problem = pair.first.first;
 
-   std::vector<double> expected_objective{ 3.0, 1.0, 0.0, 0.0 };
-   std::vector<int> expected_colsizes{ 1, 1, 1, ELIMINATED };
+   papilo::Vec<double> expected_objective{ 3.0, 1.0, 0.0, 0.0 };
+   papilo::Vec<int> expected_colsizes{ 1, 1, 1, ELIMINATED };
 
    REQUIRE( problem.getObjective().coefficients == expected_objective );
    REQUIRE( problem.getUpperBounds() == upperBounds() );
@@ -224,8 +234,8 @@ TEST_CASE( "presolve-activity-is-updated-correctly-huge-values", "[core]" )
    int rowLength = 1;
    int colindices [1] = {0};
    double rowvals [1] = {newcolcoef};
-   Vec<double> lower_bounds{};
-   Vec<double> upper_bounds{};
+   papilo::Vec<double> lower_bounds{};
+   papilo::Vec<double> upper_bounds{};
    Vec<ColFlags> flags{};
    lower_bounds.push_back(lb);
    upper_bounds.push_back(ub);
@@ -243,6 +253,551 @@ TEST_CASE( "presolve-activity-is-updated-correctly-huge-values", "[core]" )
 
 }
 
+TEST_CASE( "concurrent-rounds-presolve-problem", "[core]" )
+{
+   Problem<double> problem = setupProblemWithMultiplePresolvingOptions();
+   Problem<double> concurrent_problem =
+       setupProblemWithMultiplePresolvingOptions();
+
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   presolve.getPresolveOptions().threads = 4;
+   PresolveResult<double> result = presolve.apply( problem );
+
+   Presolve<double> concurrent_presolve{};
+   concurrent_presolve.addDefaultPresolvers();
+   concurrent_presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   concurrent_presolve.getPresolveOptions().threads = 4;
+   concurrent_presolve.getPresolveOptions().concurrent_rounds = true;
+   PresolveResult<double> concurrent_result =
+       concurrent_presolve.apply( concurrent_problem );
+
+   REQUIRE( concurrent_result.status == result.status );
+   REQUIRE( concurrent_problem.getNCols() == problem.getNCols() );
+   REQUIRE( concurrent_problem.getNRows() == problem.getNRows() );
+   REQUIRE( concurrent_problem.getObjective().offset ==
+            problem.getObjective().offset );
+}
+
+TEST_CASE( "adaptive-selection-presolve-problem", "[core]" )
+{
+   Problem<double> problem = setupProblemWithMultiplePresolvingOptions();
+   Problem<double> adaptive_problem =
+       setupProblemWithMultiplePresolvingOptions();
+
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   PresolveResult<double> result = presolve.apply( problem );
+
+   Presolve<double> adaptive_presolve{};
+   adaptive_presolve.addDefaultPresolvers();
+   adaptive_presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   adaptive_presolve.getPresolveOptions().adaptive_selection = true;
+   // skip every presolver that is not at least as productive as the average
+   adaptive_presolve.getPresolveOptions().adaptivefac = 1.0;
+   PresolveResult<double> adaptive_result =
+       adaptive_presolve.apply( adaptive_problem );
+
+   REQUIRE( adaptive_result.status == result.status );
+   REQUIRE( adaptive_problem.getNCols() == problem.getNCols() );
+   REQUIRE( adaptive_problem.getNRows() == problem.getNRows() );
+}
+
+TEST_CASE( "work-limit-is-independent-of-threads", "[core]" )
+{
+   Problem<double> problem = setupProblemWithMultiplePresolvingOptions();
+   Problem<double> parallel_problem =
+       setupProblemWithMultiplePresolvingOptions();
+
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   presolve.getPresolveOptions().threads = 1;
+   presolve.getPresolveOptions().worklim = 1;
+   presolve.getPresolveOptions()
+       .apply_results_immediately_if_run_sequentially = false;
+   PresolveResult<double> result = presolve.apply( problem );
+
+   Presolve<double> parallel_presolve{};
+   parallel_presolve.addDefaultPresolvers();
+   parallel_presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   parallel_presolve.getPresolveOptions().threads = 4;
+   parallel_presolve.getPresolveOptions().worklim = 1;
+   PresolveResult<double> parallel_result =
+       parallel_presolve.apply( parallel_problem );
+
+   REQUIRE( parallel_result.status == result.status );
+   REQUIRE( parallel_problem.getNCols() == problem.getNCols() );
+   REQUIRE( parallel_problem.getNRows() == problem.getNRows() );
+   REQUIRE( problem.getNCols() > 0 );
+}
+
+TEST_CASE( "progress-callback-and-interrupt-stop-presolve", "[core]" )
+{
+   Problem<double> problem = setupProblemWithMultiplePresolvingOptions();
+   Problem<double> interrupted_problem =
+       setupProblemWithMultiplePresolvingOptions();
+
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   int ncallbacks = 0;
+   int lastround = -1;
+   presolve.setProgressCallback( [&]( const PresolveProgress& progress ) {
+      ++ncallbacks;
+      lastround = progress.stats.nrounds;
+      REQUIRE( !progress.presolvers.empty() );
+      REQUIRE( progress.nactivecols <= problem.getNCols() );
+      return true;
+   } );
+   PresolveResult<double> result = presolve.apply( problem );
+
+   REQUIRE( ncallbacks == 1 );
+   REQUIRE( presolve.isInterrupted() );
+   REQUIRE( presolve.getStatistics().nrounds == lastround );
+
+   // interrupting from within the callback stops presolve as well
+   Presolve<double> interrupted{};
+   interrupted.addDefaultPresolvers();
+   interrupted.setVerbosityLevel( VerbosityLevel::kQuiet );
+   int ninterruptedcallbacks = 0;
+   interrupted.setProgressCallback( [&]( const PresolveProgress& ) {
+      ++ninterruptedcallbacks;
+      interrupted.interrupt();
+      return false;
+   } );
+   PresolveResult<double> interrupted_result =
+       interrupted.apply( interrupted_problem );
+
+   REQUIRE( ninterruptedcallbacks == 1 );
+   REQUIRE( interrupted_result.status == result.status );
+   REQUIRE( interrupted_problem.getNCols() == problem.getNCols() );
+   REQUIRE( interrupted_problem.getNRows() == problem.getNRows() );
+
+   // the request does not carry over to the next call
+   Problem<double> next_problem = setupProblemWithMultiplePresolvingOptions();
+   interrupted.setProgressCallback( nullptr );
+   interrupted.apply( next_problem );
+   REQUIRE( !interrupted.isInterrupted() );
+}
+
+TEST_CASE( "reused-presolve-matches-new-presolve", "[core]" )
+{
+   Presolve<double> reused{};
+   reused.addDefaultPresolvers();
+   reused.setVerbosityLevel( VerbosityLevel::kQuiet );
+
+   for( int i = 0; i < 3; ++i )
+   {
+      Problem<double> problem = setupProblemWithMultiplePresolvingOptions();
+      Presolve<double> presolve{};
+      presolve.addDefaultPresolvers();
+      presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+      PresolveResult<double> result = presolve.apply( problem );
+
+      // a different problem in between must not change the next result
+      Problem<double> other = setupProblemWithTwoComponents();
+      reused.apply( other );
+
+      Problem<double> reused_problem =
+          setupProblemWithMultiplePresolvingOptions();
+      PresolveResult<double> reused_result = reused.apply( reused_problem );
+
+      REQUIRE( reused_result.status == result.status );
+      REQUIRE( reused_problem.getNCols() == problem.getNCols() );
+      REQUIRE( reused_problem.getNRows() == problem.getNRows() );
+      REQUIRE( reused_problem.getConstraintMatrix().getNnz() ==
+               problem.getConstraintMatrix().getNnz() );
+      REQUIRE( reused_result.postsolve.origcol_mapping ==
+               result.postsolve.origcol_mapping );
+      REQUIRE( reused.getStatistics().nrounds ==
+               presolve.getStatistics().nrounds );
+   }
+}
+
+TEST_CASE( "batch-presolve-matches-presolve", "[core]" )
+{
+   Vec<Problem<double>> problems;
+   problems.push_back( setupProblemWithMultiplePresolvingOptions() );
+   problems.push_back( setupProblemWithTwoComponents() );
+   problems.push_back( setupProblemWithMultiplePresolvingOptions() );
+
+   BatchPresolve<double> batch( []( Presolve<double>& presolve ) {
+      presolve.addDefaultPresolvers();
+      presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   } );
+   batch.setThreads( 2 );
+   Vec<PresolveResult<double>> results = batch.apply( problems );
+
+   REQUIRE( results.size() == 3 );
+   REQUIRE( batch.getStatistics().ninstances == 3 );
+   REQUIRE( batch.getStatistics().nfailed == 0 );
+
+   for( int i = 0; i < 3; ++i )
+   {
+      Problem<double> problem = i == 1
+                                    ? setupProblemWithTwoComponents()
+                                    : setupProblemWithMultiplePresolvingOptions();
+      Presolve<double> presolve{};
+      presolve.addDefaultPresolvers();
+      presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+      presolve.getPresolveOptions().threads = 1;
+      PresolveResult<double> result = presolve.apply( problem, false );
+
+      REQUIRE( results[i].status == result.status );
+      REQUIRE( problems[i].getNCols() == problem.getNCols() );
+      REQUIRE( problems[i].getNRows() == problem.getNRows() );
+      REQUIRE( results[i].postsolve.origcol_mapping ==
+               result.postsolve.origcol_mapping );
+   }
+}
+
+TEST_CASE( "resumed-presolve-matches-uninterrupted-presolve", "[core]" )
+{
+   for( int i = 0; i < 2; ++i )
+   {
+      auto setup = []( Presolve<double>& presolve ) {
+         presolve.addDefaultPresolvers();
+         presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+         presolve.getPresolveOptions().threads = 1;
+         presolve.getPresolveOptions().checkpointinterval = 0.0;
+      };
+
+      Problem<double> problem = i == 0
+                                    ? setupProblemWithMultiplePresolvingOptions()
+                                    : setupProblemWithTwoComponents();
+      Vec<PresolveCheckpoint<double>> checkpoints;
+      Presolve<double> presolve{};
+      setup( presolve );
+      presolve.setCheckpointHandler(
+          [&checkpoints]( const PresolveCheckpoint<double>& checkpoint ) {
+             checkpoints.push_back( checkpoint );
+          } );
+      PresolveResult<double> result = presolve.apply( problem, false );
+
+      REQUIRE( !checkpoints.empty() );
+
+      for( PresolveCheckpoint<double>& checkpoint : checkpoints )
+      {
+         Problem<double> resumed_problem;
+         Presolve<double> resumed{};
+         setup( resumed );
+         PresolveResult<double> resumed_result =
+             resumed.resume( resumed_problem, std::move( checkpoint ) );
+
+         REQUIRE( resumed_result.status == result.status );
+         REQUIRE( resumed_problem.getNCols() == problem.getNCols() );
+         REQUIRE( resumed_problem.getNRows() == problem.getNRows() );
+         REQUIRE( resumed_problem.getConstraintMatrix().getNnz() ==
+                  problem.getConstraintMatrix().getNnz() );
+         REQUIRE( resumed_problem.getLowerBounds() ==
+                  problem.getLowerBounds() );
+         REQUIRE( resumed_problem.getUpperBounds() ==
+                  problem.getUpperBounds() );
+         REQUIRE( resumed_result.postsolve.origcol_mapping ==
+                  result.postsolve.origcol_mapping );
+         REQUIRE( resumed_result.postsolve.types == result.postsolve.types );
+         REQUIRE( resumed_result.postsolve.values ==
+                  result.postsolve.values );
+         REQUIRE( resumed.getStatistics().nrounds ==
+                  presolve.getStatistics().nrounds );
+         REQUIRE( resumed.getStatistics().ntsxapplied ==
+                  presolve.getStatistics().ntsxapplied );
+      }
+   }
+}
+
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
+TEST_CASE( "checkpoint-file-round-trip", "[core]" )
+{
+   Problem<double> problem = setupProblemWithMultiplePresolvingOptions();
+   boost::optional<PresolveCheckpoint<double>> checkpoint;
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   presolve.getPresolveOptions().checkpointinterval = 0.0;
+   presolve.setCheckpointHandler(
+       [&checkpoint]( const PresolveCheckpoint<double>& value ) {
+          if( !checkpoint )
+             checkpoint = value;
+       } );
+   presolve.apply( problem, false );
+   REQUIRE( checkpoint.is_initialized() );
+
+   const std::string filename = "checkpoint-file-round-trip.checkpoint";
+   REQUIRE( writeCheckpoint( *checkpoint, filename ) );
+   boost::optional<PresolveCheckpoint<double>> read =
+       readCheckpoint<double>( filename );
+   std::remove( filename.c_str() );
+
+   REQUIRE( read.is_initialized() );
+   REQUIRE( read->problem.getNCols() == checkpoint->problem.getNCols() );
+   REQUIRE( read->problem.getNRows() == checkpoint->problem.getNRows() );
+   REQUIRE( read->problem.getLowerBounds() ==
+            checkpoint->problem.getLowerBounds() );
+   REQUIRE( read->postsolve.types == checkpoint->postsolve.types );
+   REQUIRE( read->stats.nrounds == checkpoint->stats.nrounds );
+   REQUIRE( read->problemUpdate.random_col_perm ==
+            checkpoint->problemUpdate.random_col_perm );
+   REQUIRE( read->presolvers.size() == checkpoint->presolvers.size() );
+   REQUIRE( read->nextround == checkpoint->nextround );
+}
+#endif
+
+TEST_CASE( "problem-fingerprint-is-permutation-invariant", "[core]" )
+{
+   Problem<double> problem = setupProblemWithTwoComponents();
+   Problem<double> reversed = reverseRowsAndCols( problem );
+   uint64_t fingerprint = compute_problem_fingerprint( problem );
+
+   REQUIRE( compute_problem_fingerprint( reversed ) == fingerprint );
+
+   reversed.getObjective().coefficients[0] = 2.0;
+   REQUIRE( compute_problem_fingerprint( reversed ) != fingerprint );
+}
+
+#ifdef PAPILO_SERIALIZATION_AVAILABLE
+TEST_CASE( "presolve-cache-round-trip", "[core]" )
+{
+   Problem<double> original = setupProblemWithTwoComponents();
+   Problem<double> problem = original;
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   ParameterSet paramSet = presolve.getParameters();
+
+   PresolveCache<double> cache( "." );
+   PresolveCacheKey key = cache.computeKey( problem, paramSet, false );
+   std::remove( cache.getFilename( key ).c_str() );
+   REQUIRE( !cache.load( key, problem ).is_initialized() );
+
+   PresolveResult<double> result = presolve.apply( problem, false );
+   REQUIRE( cache.store( key, problem, result ) );
+
+   Problem<double> cached_problem = original;
+   boost::optional<PresolveResult<double>> cached =
+       cache.load( key, cached_problem );
+   REQUIRE( cached.is_initialized() );
+   REQUIRE( cached->status == result.status );
+   REQUIRE( cached->postsolve.types == result.postsolve.types );
+   REQUIRE( cached_problem.getNCols() == problem.getNCols() );
+   REQUIRE( cached_problem.getNRows() == problem.getNRows() );
+   REQUIRE( cached_problem.getObjective().offset ==
+            problem.getObjective().offset );
+
+   // a permuted problem has the same fingerprint, but the postsolve mappings
+   // of the entry do not fit to it
+   Problem<double> reversed = reverseRowsAndCols( original );
+   REQUIRE( cache.computeKey( reversed, paramSet, false ).fingerprint ==
+            key.fingerprint );
+   REQUIRE( !cache.load( key, reversed ).is_initialized() );
+
+   // other parameters lead to another entry
+   presolve.getPresolveOptions().dualreds = 0;
+   ParameterSet otherParamSet = presolve.getParameters();
+   PresolveCacheKey otherkey =
+       cache.computeKey( original, otherParamSet, false );
+   REQUIRE( otherkey.settingshash != key.settingshash );
+
+   std::remove( cache.getFilename( key ).c_str() );
+}
+#endif
+
+TEST_CASE( "component-presolve-matches-presolve-of-components", "[core]" )
+{
+   Problem<double> problem = setupProblemWithTwoComponents();
+   Problem<double> component = setupProblemWithMultiplePresolvingOptions();
+
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   presolve.getPresolveOptions().component_presolve = true;
+   presolve.getPresolveOptions().componentminnnz = 1;
+   PresolveResult<double> result = presolve.apply( problem, false );
+
+   Presolve<double> component_presolve{};
+   component_presolve.addDefaultPresolvers();
+   component_presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   PresolveResult<double> component_result =
+       component_presolve.apply( component, false );
+
+   REQUIRE( result.status == component_result.status );
+   REQUIRE( problem.getNCols() == 2 * component.getNCols() );
+   REQUIRE( problem.getNRows() == 2 * component.getNRows() );
+   REQUIRE( problem.getConstraintMatrix().getNnz() ==
+            2 * component.getConstraintMatrix().getNnz() );
+   REQUIRE( problem.getObjective().offset ==
+            2 * component.getObjective().offset );
+   REQUIRE( result.postsolve.types.size() ==
+            2 * component_result.postsolve.types.size() );
+   REQUIRE( result.postsolve.getOriginalProblem().getNCols() == 8 );
+
+   // both components are solved and the merged postsolve information yields
+   // a solution of the original problem
+   REQUIRE( problem.getNCols() == 0 );
+   Message msg{};
+   Num<double> num{};
+   Postsolve<double> postsolve{ msg, num };
+   Solution<double> reduced_solution{};
+   Solution<double> original_solution{};
+   Solution<double> component_solution{};
+   REQUIRE( postsolve.undo( reduced_solution, original_solution,
+                            result.postsolve ) == PostsolveStatus::kOk );
+   REQUIRE( postsolve.undo( reduced_solution, component_solution,
+                            component_result.postsolve ) ==
+            PostsolveStatus::kOk );
+   REQUIRE( original_solution.primal.size() == 8 );
+   for( int col = 0; col < 4; ++col )
+   {
+      REQUIRE( original_solution.primal[col] ==
+               component_solution.primal[col] );
+      REQUIRE( original_solution.primal[col + 4] ==
+               component_solution.primal[col] );
+   }
+}
+
+TEST_CASE( "warm-started-presolve-matches-presolve-of-modified-problem",
+           "[core]" )
+{
+   Problem<double> original = setupProblemWithTwoComponents();
+
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   presolve.getPresolveOptions().component_presolve = true;
+   presolve.getPresolveOptions().componentminnnz = 1;
+   presolve.getPresolveOptions().warmstart = true;
+
+   Problem<double> problem = original;
+   presolve.apply( problem, false );
+
+   // modify the second component only
+   ProblemDelta<double> delta;
+   delta.changeObj( 5, -1.0 );
+   delta.changeColUb( 4, 0.0 );
+   delta.changeRowRhs( 3, 2.0 );
+
+   Problem<double> modified = original;
+   Num<double> num{};
+   delta.apply( modified, num );
+   REQUIRE( modified.getObjective().coefficients[5] == -1.0 );
+   REQUIRE( modified.getUpperBounds()[4] == 0.0 );
+   REQUIRE( !modified.getRowFlags()[3].test( RowFlag::kEquation ) );
+
+   Presolve<double> cold_presolve{};
+   cold_presolve.addDefaultPresolvers();
+   cold_presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   cold_presolve.getPresolveOptions().component_presolve = true;
+   cold_presolve.getPresolveOptions().componentminnnz = 1;
+   PresolveResult<double> cold_result = cold_presolve.apply( modified, false );
+   REQUIRE( cold_result.postsolve.getOriginalProblem().getUpperBounds()[4] ==
+            0.0 );
+
+   auto check = [&]( const Problem<double>& reduced,
+                     const PresolveResult<double>& result ) {
+      REQUIRE( result.status == cold_result.status );
+      REQUIRE( reduced.getNCols() == modified.getNCols() );
+      REQUIRE( reduced.getNRows() == modified.getNRows() );
+      REQUIRE( reduced.getObjective().offset ==
+               modified.getObjective().offset );
+      REQUIRE( result.postsolve.types == cold_result.postsolve.types );
+      REQUIRE( result.postsolve.indices == cold_result.postsolve.indices );
+      REQUIRE( result.postsolve.values == cold_result.postsolve.values );
+      REQUIRE( result.postsolve.origcol_mapping ==
+               cold_result.postsolve.origcol_mapping );
+      REQUIRE( result.postsolve.getOriginalProblem().getUpperBounds() ==
+               cold_result.postsolve.getOriginalProblem().getUpperBounds() );
+   };
+
+   // presolves the second part again and reuses the first one
+   problem = original;
+   check( problem, presolve.reapply( problem, delta ) );
+
+   // reuses both parts
+   problem = original;
+   delta.apply( problem, num );
+   check( problem, presolve.reapply( problem, ProblemDelta<double>() ) );
+}
+
+Problem<double>
+setupProblemWithTwoComponents()
+{
+   // two disconnected copies of setupProblemWithMultiplePresolvingOptions
+   Vec<std::tuple<int, int, double>> entries{
+       std::tuple<int, int, double>{ 0, 0, 2.0 },
+       std::tuple<int, int, double>{ 0, 1, 1.0 },
+       std::tuple<int, int, double>{ 0, 2, 1.0 },
+       std::tuple<int, int, double>{ 1, 2, 1.0 },
+       std::tuple<int, int, double>{ 1, 3, 1.0 },
+       std::tuple<int, int, double>{ 2, 4, 2.0 },
+       std::tuple<int, int, double>{ 2, 5, 1.0 },
+       std::tuple<int, int, double>{ 2, 6, 1.0 },
+       std::tuple<int, int, double>{ 3, 6, 1.0 },
+       std::tuple<int, int, double>{ 3, 7, 1.0 } };
+   Vec<double> obj{ 3.0, 1.0, 1.0, 1.0, 3.0, 1.0, 1.0, 1.0 };
+   Vec<double> sides{ 2.0, 1.0, 2.0, 1.0 };
+
+   ProblemBuilder<double> pb;
+   pb.reserve( (int) entries.size(), 4, 8 );
+   pb.setNumRows( 4 );
+   pb.setNumCols( 8 );
+   pb.setColUbAll( Vec<double>( 8, 1.0 ) );
+   pb.setColLbAll( Vec<double>( 8, 0.0 ) );
+   pb.setObjAll( obj );
+   pb.setObjOffset( 0.0 );
+   pb.setColIntegralAll( Vec<uint8_t>( 8, 1 ) );
+   pb.setRowRhsAll( sides );
+   pb.setRowLhsAll( sides );
+   pb.addEntryAll( entries );
+   pb.setProblemName( "matrix with two components" );
+   return pb.build();
+}
+
+Problem<double>
+reverseRowsAndCols( const Problem<double>& problem )
+{
+   const ConstraintMatrix<double>& matrix = problem.getConstraintMatrix();
+   const int nrows = problem.getNRows();
+   const int ncols = problem.getNCols();
+
+   ProblemBuilder<double> pb;
+   pb.reserve( (int) matrix.getNnz(), nrows, ncols );
+   pb.setNumRows( nrows );
+   pb.setNumCols( ncols );
+   for( int col = 0; col < ncols; ++col )
+   {
+      const int newcol = ncols - 1 - col;
+      pb.setColLb( newcol, problem.getLowerBounds()[col] );
+      pb.setColUb( newcol, problem.getUpperBounds()[col] );
+      pb.setColLbInf( newcol,
+                      problem.getColFlags()[col].test( ColFlag::kLbInf ) );
+      pb.setColUbInf( newcol,
+                      problem.getColFlags()[col].test( ColFlag::kUbInf ) );
+      pb.setColIntegral( newcol,
+                         problem.getColFlags()[col].test( ColFlag::kIntegral ) );
+      pb.setObj( newcol, problem.getObjective().coefficients[col] );
+   }
+   for( int row = 0; row < nrows; ++row )
+   {
+      const int newrow = nrows - 1 - row;
+      pb.setRowLhs( newrow, matrix.getLeftHandSides()[row] );
+      pb.setRowRhs( newrow, matrix.getRightHandSides()[row] );
+      pb.setRowLhsInf( newrow,
+                       matrix.getRowFlags()[row].test( RowFlag::kLhsInf ) );
+      pb.setRowRhsInf( newrow,
+                       matrix.getRowFlags()[row].test( RowFlag::kRhsInf ) );
+      auto rowvec = matrix.getRowCoefficients( row );
+      for( int i = 0; i < rowvec.getLength(); ++i )
+         pb.addEntry( newrow, ncols - 1 - rowvec.getIndices()[i],
+                      rowvec.getValues()[i] );
+   }
+   pb.setObjOffset( problem.getObjective().offset );
+   pb.setProblemName( "reversed " + problem.getName() );
+   return pb.build();
+}
+
 Problem<double>
 setupProblemWithMultiplePresolvingOptions()
 {
@@ -34,6 +34,16 @@ setupProblemPresolveSingletonRow();
 Problem<double>
 setupProblemPresolveSingletonRowFixed();
 
+Problem<double>
+setupProblemWithManyBoundChanges();
+
+Problem<double>
+setupArrowheadProblem();
+
+void
+applyBoundChanges( Problem<double>& problem, ProblemUpdate<double>& update,
+                   bool defer );
+
 TEST_CASE( "trivial-presolve-singleton-row", "[core]" )
 {
    Num<double> num{};
@@ -69,6 +79,141 @@ TEST_CASE( "trivial-presolve-singleton-row-pt-2", "[core]" )
    REQUIRE( problemUpdate.getSingletonCols().size() == 2 );
 }
 
+TEST_CASE( "deferred-activity-updates-are-identical", "[core]" )
+{
+   Num<double> num{};
+   Message msg{};
+   Problem<double> problem = setupProblemWithManyBoundChanges();
+   Problem<double> deferred_problem = setupProblemWithManyBoundChanges();
+   Statistics statistics{};
+   Statistics deferred_statistics{};
+   PresolveOptions presolveOptions{};
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   PostsolveStorage<double> deferred_postsolve =
+       PostsolveStorage<double>( deferred_problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+   ProblemUpdate<double> deferredUpdate( deferred_problem, deferred_postsolve,
+                                         deferred_statistics, presolveOptions,
+                                         num, msg );
+
+   applyBoundChanges( problem, problemUpdate, false );
+   applyBoundChanges( deferred_problem, deferredUpdate, true );
+
+   REQUIRE( !problemUpdate.getChangedActivities().empty() );
+   REQUIRE( deferredUpdate.getChangedActivities() ==
+            problemUpdate.getChangedActivities() );
+
+   for( int row = 0; row < problem.getNRows(); ++row )
+   {
+      const RowActivity<double>& activity = problem.getRowActivities()[row];
+      const RowActivity<double>& deferred_activity =
+          deferred_problem.getRowActivities()[row];
+      REQUIRE( deferred_activity.min == activity.min );
+      REQUIRE( deferred_activity.max == activity.max );
+      REQUIRE( deferred_activity.ninfmin == activity.ninfmin );
+      REQUIRE( deferred_activity.ninfmax == activity.ninfmax );
+      REQUIRE( deferred_activity.lastchange == activity.lastchange );
+   }
+}
+
+TEST_CASE( "block-structure-of-arrowhead-matrix", "[core]" )
+{
+   Num<double> num{};
+   Message msg{};
+   Problem<double> problem = setupArrowheadProblem();
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   presolveOptions.maxlinkingfrac = 0.15;
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+
+   REQUIRE( problemUpdate.detectBlockStructure() == 3 );
+
+   const BlockStructure& blocks = problemUpdate.getBlockStructure();
+   REQUIRE( blocks.hasBlocks() );
+   REQUIRE( blocks.getNLinkingRows() == 1 );
+   REQUIRE( blocks.getNLinkingCols() == 1 );
+   for( int i = 0; i < 6; ++i )
+   {
+      REQUIRE( blocks.getRowBlock( i ) == i / 2 );
+      REQUIRE( blocks.getColBlock( i ) == i / 2 );
+   }
+   REQUIRE( blocks.getRowBlock( 6 ) == BlockStructure::LINKING );
+   REQUIRE( blocks.getColBlock( 6 ) == BlockStructure::LINKING );
+
+   Vec<int> rows;
+   Vec<int> start;
+   blocks.getRowPartition( rows, start );
+   REQUIRE( start == Vec<int>{ 0, 2, 4, 6, 7 } );
+   REQUIRE( rows == Vec<int>{ 0, 1, 2, 3, 4, 5, 6 } );
+
+   // the labels follow the rows and columns when they are compressed
+   BlockStructure compressed = blocks;
+   compressed.compress( Vec<int>{ -1, 0, 1, 2, 3, 4, 5 },
+                        Vec<int>{ 0, -1, 1, 2, 3, 4, 5 } );
+   REQUIRE( compressed.getRowBlock( 0 ) == 0 );
+   REQUIRE( compressed.getRowBlock( 1 ) == 1 );
+   REQUIRE( compressed.getColBlock( 1 ) == 1 );
+   REQUIRE( compressed.getColBlock( 5 ) == BlockStructure::LINKING );
+
+   // the structure is detected again once most linking rows and columns are
+   // removed
+   REQUIRE( !blocks.isStale( problem ) );
+   problem.getRowFlags()[6].set( RowFlag::kRedundant );
+   REQUIRE( blocks.isStale( problem ) );
+   problemUpdate.check_and_compress();
+   REQUIRE( blocks.getNBlocks() == 3 );
+   REQUIRE( blocks.getNLinkingRows() == 0 );
+   REQUIRE( blocks.getNLinkingCols() == 1 );
+   REQUIRE( !blocks.isStale( problem ) );
+   problem.getRowFlags()[6].unset( RowFlag::kRedundant );
+
+   // without a linking row and column the matrix has only one block
+   presolveOptions.maxlinkingfrac = 0.0;
+   REQUIRE( problemUpdate.detectBlockStructure() == 1 );
+   REQUIRE( !problemUpdate.getBlockStructure().hasBlocks() );
+}
+
+void
+applyBoundChanges( Problem<double>& problem, ProblemUpdate<double>& update,
+                   bool defer )
+{
+   Reductions<double> reductions{};
+   for( int col = 0; col < problem.getNCols(); ++col )
+   {
+      TransactionGuard<double> tg{ reductions };
+      if( col % 4 == 0 )
+         reductions.fixCol( col, 2.0 );
+      else
+      {
+         reductions.changeColLB( col, 1.0 );
+         reductions.changeColUB( col, 5.0 );
+      }
+   }
+
+   // the side changes interrupt the bound changes
+   for( int row = 0; row < problem.getNRows(); row += 50 )
+   {
+      TransactionGuard<double> tg{ reductions };
+      reductions.changeRowRHS( row, 1e5 );
+   }
+
+   update.setDeferActivityUpdates( defer );
+
+   const auto& reds = reductions.getReductions();
+   for( const auto& transaction : reductions.getTransactions() )
+      REQUIRE( update.applyTransaction( &reds[transaction.start],
+                                        reds.data() + transaction.end,
+                                        ArgumentType::kPrimal ) ==
+               ApplyResult::kApplied );
+
+   update.setDeferActivityUpdates( false );
+}
+
 Problem<double>
 setupProblemPresolveSingletonRow()
 {
@@ -139,4 +284,77 @@ setupProblemPresolveSingletonRowFixed()
    problem.getConstraintMatrix().modifyLeftHandSide( 1,num, rhs[1] );
    return problem;
 }
+Problem<double>
+setupProblemWithManyBoundChanges()
+{
+   // enough coefficients to update the activities in parallel
+   const int nrows = 200;
+   const int ncols = 400;
+
+   ProblemBuilder<double> pb;
+   pb.setNumRows( nrows );
+   pb.setNumCols( ncols );
+
+   for( int col = 0; col < ncols; ++col )
+   {
+      pb.setColLb( col, 0.0 );
+      pb.setColUb( col, 10.0 );
+      pb.setColUbInf( col, col % 3 == 0 );
+      pb.setObj( col, 1.0 );
+      for( int row = ( 7 * col ) % 5; row < nrows; row += 5 )
+         pb.addEntry( row, col, ( ( row + col ) % 7 ) - 3.5 );
+      // the first row is dense, so that every bound change updates it
+      if( ( 7 * col ) % 5 != 0 )
+         pb.addEntry( 0, col, 0.5 );
+   }
+
+   for( int row = 0; row < nrows; ++row )
+   {
+      pb.setRowLhsInf( row, true );
+      pb.setRowRhs( row, 1e6 );
+   }
+
+   pb.setProblemName( "matrix with many bound changes" );
+   Problem<double> problem = pb.build();
+   problem.recomputeAllActivities();
+   return problem;
+}
+
+Problem<double>
+setupArrowheadProblem()
+{
+   // three 2x2 blocks, the last row and column link all of them
+   const int nblocks = 3;
+   const int n = 2 * nblocks + 1;
+
+   ProblemBuilder<double> pb;
+   pb.setNumRows( n );
+   pb.setNumCols( n );
+
+   for( int col = 0; col < n; ++col )
+   {
+      pb.setColLb( col, 0.0 );
+      pb.setColUb( col, 10.0 );
+      pb.setObj( col, 1.0 );
+   }
+
+   for( int row = 0; row < n - 1; ++row )
+   {
+      int first = row - row % 2;
+      pb.addEntry( row, first, 1.0 + row );
+      pb.addEntry( row, first + 1, 2.0 );
+      pb.addEntry( row, n - 1, 1.0 );
+      pb.setRowLhsInf( row, true );
+      pb.setRowRhs( row, 10.0 );
+   }
+
+   for( int col = 0; col < n; ++col )
+      pb.addEntry( n - 1, col, 1.0 );
+   pb.setRowLhsInf( n - 1, true );
+   pb.setRowRhs( n - 1, 20.0 );
+
+   pb.setProblemName( "arrowhead matrix" );
+   return pb.build();
+}
+
 } // namespace papilo
@@ -0,0 +1,180 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "papilo/core/SingleRow.hpp"
+#include "papilo/external/catch/catch.hpp"
+#include "papilo/misc/Timer.hpp"
+#include "papilo/misc/fmt.hpp"
+#include <random>
+
+using namespace papilo;
+
+static void
+setupRandomDomains( int ncols, std::mt19937& rng, Vec<double>& lbs,
+                    Vec<double>& ubs, Vec<ColFlags>& flags );
+
+static void
+setupRandomRow( int rowlen, int ncols, std::mt19937& rng, Vec<double>& vals,
+                Vec<int>& inds );
+
+TEST_CASE( "row-activity-matches-scalar-kernel", "[core]" )
+{
+   std::mt19937 rng( 42 );
+   const int ncols = 200;
+   Vec<double> lbs;
+   Vec<double> ubs;
+   Vec<ColFlags> flags;
+   setupRandomDomains( ncols, rng, lbs, ubs, flags );
+
+   // cover rows shorter than a vector register and rows with a remainder
+   for( int rowlen : { 0, 1, 3, 4, 7, 8, 9, 17, 64, 131 } )
+   {
+      Vec<double> vals;
+      Vec<int> inds;
+      setupRandomRow( rowlen, ncols, rng, vals, inds );
+
+      RowActivity<double> expected;
+      expected.min = 0.0;
+      expected.max = 0.0;
+      expected.ninfmin = 0;
+      expected.ninfmax = 0;
+      accumulate_row_activity( expected, vals.data(), inds.data(), rowlen, lbs,
+                               ubs, flags );
+
+      RowActivity<double> activity = compute_row_activity(
+          vals.data(), inds.data(), rowlen, lbs, ubs, flags, 3 );
+
+      REQUIRE( activity.lastchange == 3 );
+      REQUIRE( activity.ninfmin == expected.ninfmin );
+      REQUIRE( activity.ninfmax == expected.ninfmax );
+      REQUIRE( activity.min == Approx( expected.min ) );
+      REQUIRE( activity.max == Approx( expected.max ) );
+   }
+}
+
+TEST_CASE( "row-activity-benchmark", "[.][benchmark]" )
+{
+   std::mt19937 rng( 7 );
+   // keep the bounds cache resident to measure the kernel and not the memory
+   const int ncols = 1 << 12;
+   const long long nnzperbucket = 1 << 24;
+   Vec<double> lbs;
+   Vec<double> ubs;
+   Vec<ColFlags> flags;
+   setupRandomDomains( ncols, rng, lbs, ubs, flags );
+
+   fmt::print( "{:>8} {:>12} {:>12} {:>8}\n", "rowlen", "scalar[s]",
+               "kernel[s]", "speedup" );
+
+   for( int rowlen : { 2, 4, 8, 16, 32, 64, 256, 1024 } )
+   {
+      Vec<double> vals;
+      Vec<int> inds;
+      setupRandomRow( rowlen, ncols, rng, vals, inds );
+      const long long nreps = nnzperbucket / rowlen;
+
+      double scalartime = 0.0;
+      double kerneltime = 0.0;
+      double checksum = 0.0;
+      {
+         Timer timer( scalartime );
+         for( long long i = 0; i != nreps; ++i )
+         {
+            RowActivity<double> activity;
+            activity.min = 0.0;
+            activity.max = 0.0;
+            activity.ninfmin = 0;
+            activity.ninfmax = 0;
+            accumulate_row_activity( activity, vals.data(), inds.data(),
+                                     rowlen, lbs, ubs, flags );
+            checksum += activity.min;
+         }
+      }
+      {
+         Timer timer( kerneltime );
+         for( long long i = 0; i != nreps; ++i )
+            checksum -= compute_row_activity( vals.data(), inds.data(), rowlen,
+                                              lbs, ubs, flags )
+                            .min;
+      }
+
+      fmt::print( "{:>8} {:>12.4f} {:>12.4f} {:>8.2f}   (checksum {:.1e})\n",
+                  rowlen, scalartime, kerneltime,
+                  kerneltime > 0 ? scalartime / kerneltime : 0.0, checksum );
+   }
+}
+
+static void
+setupRandomDomains( int ncols, std::mt19937& rng, Vec<double>& lbs,
+                    Vec<double>& ubs, Vec<ColFlags>& flags )
+{
+   std::uniform_real_distribution<double> bound( -10.0, 10.0 );
+   std::uniform_int_distribution<int> kind( 0, 9 );
+
+   lbs.resize( ncols );
+   ubs.resize( ncols );
+   flags.resize( ncols );
+
+   for( int i = 0; i != ncols; ++i )
+   {
+      lbs[i] = bound( rng );
+      ubs[i] = lbs[i] + 10.0;
+      flags[i] = ColFlags();
+
+      switch( kind( rng ) )
+      {
+      case 0:
+         lbs[i] = -std::numeric_limits<double>::infinity();
+         flags[i].set( ColFlag::kLbInf );
+         break;
+      case 1:
+         ubs[i] = std::numeric_limits<double>::infinity();
+         flags[i].set( ColFlag::kUbInf );
+         break;
+      case 2:
+         ubs[i] = 1e30;
+         flags[i].set( ColFlag::kUbHuge );
+         break;
+      }
+   }
+}
+
+static void
+setupRandomRow( int rowlen, int ncols, std::mt19937& rng, Vec<double>& vals,
+                Vec<int>& inds )
+{
+   std::uniform_real_distribution<double> coef( -5.0, 5.0 );
+   std::uniform_int_distribution<int> col( 0, ncols - 1 );
+
+   vals.resize( rowlen );
+   inds.resize( rowlen );
+
+   for( int j = 0; j != rowlen; ++j )
+   {
+      do
+         vals[j] = coef( rng );
+      while( vals[j] == 0.0 );
+      inds[j] = col( rng );
+   }
+
+   std::sort( inds.begin(), inds.end() );
+}
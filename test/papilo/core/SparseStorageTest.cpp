@@ -23,10 +23,19 @@
 #include "papilo/core/SparseStorage.hpp"
 #include "papilo/external/catch/catch.hpp"
 #include "papilo/misc/compress_vector.hpp"
+#include <random>
 
 papilo::SparseStorage<double>
 setupSparseMatrix();
 
+papilo::SparseStorage<double>
+setupLargeSparseMatrix( papilo::Vec<int>& rowSizes,
+                        papilo::Vec<int>& columnSizes );
+
+void
+checkSameLayout( const papilo::SparseStorage<double>& expected,
+                 const papilo::SparseStorage<double>& actual );
+
 TEST_CASE( "sparse storage can be created from triplets", "[core]" )
 {
    papilo::SparseStorage<double> matrix = setupSparseMatrix();
@@ -308,6 +317,139 @@ TEST_CASE( "transposed sparse matrix can be compressed", "[core]" )
    }
 }
 
+#ifdef PAPILO_TBB
+TEST_CASE( "parallel-transpose-and-compress-match-sequential", "[core]" )
+{
+   papilo::Vec<int> rowSizes;
+   papilo::Vec<int> columnSizes;
+   const papilo::SparseStorage<double> matrix =
+       setupLargeSparseMatrix( rowSizes, columnSizes );
+
+   for( bool full : { false, true } )
+   {
+      papilo::SparseStorage<double> sequential;
+      papilo::SparseStorage<double> sequentialTranspose;
+      papilo::Vec<int> sequentialMapping;
+      papilo::Vec<int> sequentialTransposeMapping;
+
+      tbb::task_arena( 1 ).execute( [&]() {
+         sequential = matrix;
+         sequentialTranspose = matrix.getTranspose();
+         sequentialMapping =
+             sequential.compress( rowSizes, columnSizes, full );
+         sequentialTransposeMapping =
+             sequentialTranspose.compress( columnSizes, rowSizes, full );
+      } );
+
+      papilo::SparseStorage<double> parallel;
+      papilo::SparseStorage<double> parallelTranspose;
+      papilo::Vec<int> parallelMapping;
+      papilo::Vec<int> parallelTransposeMapping;
+
+      tbb::task_arena( 4 ).execute( [&]() {
+         parallel = matrix;
+         parallelTranspose = matrix.getTranspose();
+         checkSameLayout( matrix.getTranspose(), parallelTranspose );
+         parallelMapping = parallel.compress( rowSizes, columnSizes, full );
+         parallelTransposeMapping =
+             parallelTranspose.compress( columnSizes, rowSizes, full );
+      } );
+
+      REQUIRE( parallelMapping == sequentialMapping );
+      REQUIRE( parallelTransposeMapping == sequentialTransposeMapping );
+      checkSameLayout( sequential, parallel );
+      checkSameLayout( sequentialTranspose, parallelTranspose );
+   }
+}
+#endif
+
+papilo::SparseStorage<double>
+setupLargeSparseMatrix( papilo::Vec<int>& rowSizes,
+                        papilo::Vec<int>& columnSizes )
+{
+   // random matrix with enough nonzeros to be split into several blocks where
+   // every 7th row and every 5th column is deleted and therefore empty
+   const int numberRows = 20000;
+   const int numberColumns = 5000;
+   std::mt19937 rng( 1234 );
+   std::uniform_int_distribution<int> rowLength( 0, 30 );
+   std::uniform_int_distribution<int> column( 0, numberColumns - 1 );
+   std::uniform_int_distribution<int> value( -5, 5 );
+
+   rowSizes.assign( numberRows, 0 );
+   columnSizes.assign( numberColumns, 0 );
+   for( int col = 0; col < numberColumns; col += 5 )
+      columnSizes[col] = -1;
+
+   papilo::Vec<papilo::Triplet<double>> triplets;
+
+   for( int row = 0; row < numberRows; ++row )
+   {
+      if( row % 7 == 0 )
+      {
+         rowSizes[row] = -1;
+         continue;
+      }
+
+      for( int k = rowLength( rng ); k > 0; --k )
+      {
+         const int col = column( rng );
+         const int val = value( rng );
+         if( col % 5 != 0 && val != 0 )
+            triplets.emplace_back( row, col, double( val ) );
+      }
+   }
+
+   // merge duplicate entries by keeping the first one
+   pdqsort( triplets.begin(), triplets.end() );
+   triplets.erase(
+       std::unique( triplets.begin(), triplets.end(),
+                    []( const papilo::Triplet<double>& a,
+                        const papilo::Triplet<double>& b ) {
+                       return std::get<0>( a ) == std::get<0>( b ) &&
+                              std::get<1>( a ) == std::get<1>( b );
+                    } ),
+       triplets.end() );
+
+   for( const auto& triplet : triplets )
+   {
+      ++rowSizes[std::get<0>( triplet )];
+      ++columnSizes[std::get<1>( triplet )];
+   }
+
+   return papilo::SparseStorage<double>( triplets, numberRows, numberColumns,
+                                         true );
+}
+
+void
+checkSameLayout( const papilo::SparseStorage<double>& expected,
+                 const papilo::SparseStorage<double>& actual )
+{
+   REQUIRE( actual.getNRows() == expected.getNRows() );
+   REQUIRE( actual.getNCols() == expected.getNCols() );
+   REQUIRE( actual.getNnz() == expected.getNnz() );
+   REQUIRE( actual.getNAlloc() == expected.getNAlloc() );
+   REQUIRE( actual.getValuesVec().size() == expected.getValuesVec().size() );
+
+   auto expectedRanges = expected.getRowRanges();
+   auto actualRanges = actual.getRowRanges();
+
+   bool equal = true;
+   for( int r = 0; r <= expected.getNRows() && equal; ++r )
+   {
+      equal = actualRanges[r].start == expectedRanges[r].start &&
+              actualRanges[r].end == expectedRanges[r].end;
+
+      for( auto j = expectedRanges[r].start;
+           r != expected.getNRows() && equal && j != expectedRanges[r].end;
+           ++j )
+         equal = actual.getColumns()[j] == expected.getColumns()[j] &&
+                 actual.getValues()[j] == expected.getValues()[j];
+   }
+
+   REQUIRE( equal );
+}
+
 papilo::SparseStorage<double>
 setupSparseMatrix()
 {
@@ -0,0 +1,74 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*               This file is part of the program and library                */
+/*    PaPILO --- Parallel Presolve for Integer and Linear Optimization       */
+/*                                                                           */
+/* Copyright (C) 2020-2024 Zuse Institute Berlin (ZIB)                       */
+/*                                                                           */
+/* This program is free software: you can redistribute it and/or modify      */
+/* it under the terms of the GNU Lesser General Public License as published  */
+/* by the Free Software Foundation, either version 3 of the License, or      */
+/* (at your option) any later version.                                       */
+/*                                                                           */
+/* This program is distributed in the hope that it will be useful,           */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of            */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             */
+/* GNU Lesser General Public License for more details.                       */
+/*                                                                           */
+/* You should have received a copy of the GNU Lesser General Public License  */
+/* along with this program.  If not, see <https://www.gnu.org/licenses/>.    */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "papilo/misc/RoundArena.hpp"
+#include "papilo/core/Reductions.hpp"
+#include "papilo/external/catch/catch.hpp"
+
+using namespace papilo;
+
+TEST_CASE( "round-arena-allocator", "[misc]" )
+{
+   RoundArena arena;
+   REQUIRE( arena.getPeakBytes() == 0 );
+
+   Reductions<double> reductions( &arena );
+   for( int i = 0; i < 100000; ++i )
+   {
+      reductions.startTransaction();
+      reductions.changeColLB( i, double( i ) );
+      reductions.endTransaction();
+   }
+
+   REQUIRE( reductions.getReductions().size() == 100000 );
+   REQUIRE( reductions.getTransactions().size() == 100000 );
+   for( int i = 0; i < 100000; i += 997 )
+   {
+      REQUIRE( reductions.getReductions()[i].col == i );
+      REQUIRE( reductions.getReductions()[i].newval == double( i ) );
+   }
+
+   std::size_t peak = arena.getPeakBytes();
+   REQUIRE( peak >= 100000 * sizeof( Reduction<double> ) );
+
+   // after releasing the reductions the memory of the arena is reused, so
+   // the peak does not grow when the same reductions are stored again
+   reductions.release();
+   arena.reset();
+   REQUIRE( reductions.getReductions().empty() );
+
+   for( int i = 0; i < 100000; ++i )
+   {
+      reductions.startTransaction();
+      reductions.changeColLB( i, double( i ) );
+      reductions.endTransaction();
+   }
+
+   REQUIRE( reductions.getReductions().size() == 100000 );
+   REQUIRE( arena.getPeakBytes() == peak );
+
+   // without an arena the default allocator is used
+   Reductions<double> plain;
+   plain.changeColUB( 3, 1.0 );
+   REQUIRE( plain.getReductions().size() == 1 );
+   REQUIRE( plain.getReductions()[0].row == ColReduction::UPPER_BOUND );
+}
@@ -229,6 +229,43 @@ TEST_CASE( "domcol-multiple-columns", "[presolve]" )
    }
 }
 
+TEST_CASE( "domcol-reports-work-and-stops-at-work-budget", "[presolve]" )
+{
+   double time = 0.0;
+   int cause = -1;
+   Timer t{ time };
+   Num<double> num{};
+   Message msg{};
+   Problem<double> problem = setupMatrixForMultipleDominatedCols();
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+   problem.recomputeAllActivities();
+   const double nnz = problem.getConstraintMatrix().getNnz();
+
+   DominatedCols<double> presolvingMethod{};
+   Reductions<double> reductions{};
+   PresolveStatus presolveStatus = presolvingMethod.run(
+       problem, problemUpdate, num, reductions, t, cause );
+   REQUIRE( presolveStatus == PresolveStatus::kReduced );
+   // the signatures visit every nonzero, the scans of the shortest rows and
+   // the dominance checks come on top
+   REQUIRE( presolvingMethod.getWork() > nnz );
+
+   // the signatures use up the budget, no column is scanned
+   DominatedCols<double> limitedMethod{};
+   limitedMethod.setWorkBudget( 1.0 );
+   Reductions<double> limitedReductions{};
+   presolveStatus = limitedMethod.run( problem, problemUpdate, num,
+                                       limitedReductions, t, cause );
+   REQUIRE( presolveStatus == PresolveStatus::kUnchanged );
+   REQUIRE( limitedReductions.size() == 0 );
+   REQUIRE( limitedMethod.getWork() == nnz );
+}
+
 Problem<double>
 setupMatrixForDominatedCols()
 {
@@ -81,6 +81,55 @@ int cause = -1;
    REQUIRE( presolveStatus == PresolveStatus::kUnchanged );
 }
 
+TEST_CASE( "parallel-row-rehashes-modified-rows", "[presolve]" )
+{
+   Num<double> num{};
+   double time = 0.0;
+   int cause = -1;
+   Timer t{ time };
+   Message msg{};
+   Problem<double> problem = setupProblemWithNoParallelRows();
+   problem.recomputeAllActivities();
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+   problemUpdate.checkChangedActivities();
+   ParallelRowDetection<double> presolvingMethod{};
+   Reductions<double> reductions{};
+
+   REQUIRE( presolvingMethod.execute( problem, problemUpdate, num, reductions,
+                                      t, cause ) == PresolveStatus::kUnchanged );
+
+   // the third row becomes parallel to the first one and is the only row
+   // that is hashed again
+   Reductions<double> coefchange{};
+   {
+      TransactionGuard<double> tg{ coefchange };
+      coefchange.lockRow( 2 );
+      coefchange.changeMatrixEntry( 2, 2, 6.0 );
+   }
+   const auto& reds = coefchange.getReductions();
+   REQUIRE( problemUpdate.applyTransaction( reds.data(),
+                                            reds.data() + reds.size(),
+                                            ArgumentType::kPrimal ) ==
+            ApplyResult::kApplied );
+   problemUpdate.flushChangedCoeffs();
+   problemUpdate.clearStates();
+
+   REQUIRE( presolvingMethod.execute( problem, problemUpdate, num, reductions,
+                                      t, cause ) == PresolveStatus::kReduced );
+   REQUIRE( reductions.getReduction( 0 ).col == RowReduction::LOCKED );
+   REQUIRE( reductions.getReduction( 1 ).col == RowReduction::LOCKED );
+   REQUIRE( reductions.getReduction( 0 ).row +
+                reductions.getReduction( 1 ).row ==
+            2 );
+   REQUIRE( reductions.getReduction( 0 ).row !=
+            reductions.getReduction( 1 ).row );
+}
+
 TEST_CASE( "parallel-row-two-equations-infeasible-second-row-dominant",
            "[presolve]" )
 {
@@ -225,6 +225,43 @@ TEST_CASE( "failed-path-sparsify-if-misses-two-for-continuous", "[presolve]" )
    REQUIRE( presolveStatus == PresolveStatus::kUnchanged );
 }
 
+TEST_CASE( "sparsify-reports-work-and-stops-at-work-budget", "[presolve]" )
+{
+   Num<double> num{};
+   double time = 0.0;
+   int cause = -1;
+   Timer t{ time };
+   Message msg{};
+   Problem<double> problem = setupProblemWithSparsify();
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+   problem.recomputeAllActivities();
+
+   Sparsify<double> presolvingMethod{};
+   presolvingMethod.setDelayed( false );
+   Reductions<double> reductions{};
+   PresolveStatus presolveStatus = presolvingMethod.run(
+       problem, problemUpdate, num, reductions, t, cause );
+   REQUIRE( presolveStatus == PresolveStatus::kReduced );
+   // the scan of the rows and the nonzeros visited for the equality
+   REQUIRE( presolvingMethod.getWork() > problem.getNRows() );
+
+   // the scan of the rows uses up the budget, no equality is tried
+   Sparsify<double> limitedMethod{};
+   limitedMethod.setDelayed( false );
+   limitedMethod.setWorkBudget( 1.0 );
+   Reductions<double> limitedReductions{};
+   presolveStatus = limitedMethod.run( problem, problemUpdate, num,
+                                       limitedReductions, t, cause );
+   REQUIRE( presolveStatus == PresolveStatus::kUnchanged );
+   REQUIRE( limitedReductions.size() == 0 );
+   REQUIRE( limitedMethod.getWork() == problem.getNRows() );
+}
+
 Problem<double>
 setupProblemWithSparsify()
 {